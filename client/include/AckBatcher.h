@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../include/TimerWheel.h"
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+enum class AckMode {
+    AUTO,
+    CLIENT,
+    CLIENT_INDIVIDUAL
+};
+
+// Acknowledgements for subscriptions in client or client-individual mode, batched.
+// A message is acked once handled; the ACKs pile up until batchSize messages are
+// waiting or interval has passed since the first of them, and then go out together in
+// one write. In client mode an ACK is cumulative, so only the latest message of each
+// subscription is acked. Any frame sent meanwhile takes the waiting ACKs along (drain()),
+// so under two-way traffic they cost no write of their own.
+// Subscriptions in auto mode cost one atomic load per message.
+class AckBatcher {
+public:
+    typedef TimerWheel::Clock Clock;
+
+private:
+    struct Subscription {
+        AckMode mode;
+        // Client mode: the ack id of the latest handled message, empty if acked
+        std::string latest;
+        // Client-individual mode: every handled message not acked yet
+        std::vector<std::string> ids;
+        // Messages the waiting ACKs cover
+        size_t waiting;
+    };
+
+    TimerWheel& wheel;
+    // Writes the waiting ACKs (through drain()), called on the timer thread
+    std::function<void()> flush;
+
+    // Guards everything below
+    std::mutex mtx;
+    std::unordered_map<uint64_t, Subscription> subscriptions;
+    // Subscriptions not in auto mode
+    std::atomic<size_t> acking;
+    size_t batchSize;
+    Clock::duration interval;
+    // Messages handled and not acked yet, over all subscriptions
+    size_t waiting;
+    // Subscriptions with ACKs waiting, so a drain doesn't walk every subscription
+    std::vector<uint64_t> dirty;
+    TimerWheel::TimerId timer;
+
+    uint64_t ackFrames;
+    uint64_t messagesAcked;
+    uint64_t flushes;
+    uint64_t piggybacked;
+
+    bool add(const std::string& frameStr, bool handled);
+    void onTimer();
+
+public:
+    explicit AckBatcher(std::function<void()> flush, TimerWheel& wheel = TimerWheel::shared());
+    ~AckBatcher();
+    AckBatcher(const AckBatcher&) = delete;
+    AckBatcher& operator=(const AckBatcher&) = delete;
+
+    // "auto", "client" or "client-individual"
+    static bool parseMode(const std::string& name, AckMode& mode);
+    static const char* modeName(AckMode mode);
+
+    void setBatchSize(size_t messages);
+    void setInterval(std::chrono::milliseconds flushInterval);
+
+    // Called on join, before the SUBSCRIBE is sent; auto mode needs no tracking
+    void track(uint64_t id, AckMode mode);
+    // ACKs still waiting for the subscription are dropped: drain() before the UNSUBSCRIBE
+    void untrack(uint64_t id);
+    // Forget every subscription, at the end of a session
+    void reset();
+
+    // A raw MESSAGE the application is done with. Returns true when a batch is full and
+    // the caller should flush now rather than wait for the timer.
+    bool onHandled(const std::string& frameStr);
+    // A raw MESSAGE dropped unhandled. Acked in client-individual mode only: in client
+    // mode a later cumulative ACK covers it.
+    bool onDropped(const std::string& frameStr);
+
+    // Append an ACK frame, NULL included, for everything waiting. piggyback: whether the
+    // write carries other frames too. Returns the number of ACK frames appended.
+    size_t drain(std::string& wire, bool piggyback);
+
+    void printStats(std::ostream& out);
+};
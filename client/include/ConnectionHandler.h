@@ -2,6 +2,10 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
 #include <boost/asio.hpp>
 
 using boost::asio::ip::tcp;
@@ -12,6 +16,27 @@ private:
 	const short port_;
 	boost::asio::io_service io_service_;   // Provides core I/O functionality
 	tcp::socket socket_;
+	// Bytes received but not consumed yet; reads fill it a socket buffer at a time
+	std::vector<char> inbox_;
+	size_t inboxPos_;
+	// Kernel receive timestamps (SO_TIMESTAMPING): whether reads ask for them, and the
+	// one of the latest read
+	bool receiveTimestamps_;
+	std::chrono::system_clock::time_point inboxReceivedAt_;
+	// steady_clock ticks of the latest read and write, for heart-beating
+	std::atomic<int64_t> lastReadAt_;
+	std::atomic<int64_t> lastWriteAt_;
+	// A frame broke the framing; nothing after it can be trusted
+	bool badFrame_;
+
+	// Read whatever is available (at least one byte) into inbox_
+	bool fillInbox();
+	// Step over EOLs between frames: heart-beats, or the optional ones after a NULL
+	void skipHeartBeats();
+	// Move the complete frames in inbox_ to frames, without reading. A body that isn't
+	// followed by a NULL where its content-length says shuts the connection down.
+	void takeFrames(std::vector<std::string> &frames, char delimiter,
+	                std::vector<std::chrono::system_clock::time_point> *receivedAt);
 
 public:
 	ConnectionHandler(std::string host, short port);
@@ -29,6 +54,10 @@ public:
 	// Returns false in case the connection is closed before all the data is sent.
 	bool sendBytes(const char bytes[], int bytesToWrite);
 
+	// Send one byte only if the socket takes it without blocking, as a heart-beat must.
+	// Returns false if it wasn't sent.
+	bool sendByteNow(char byte);
+
 	// Read an ascii line from the server
 	// Returns false in case connection closed before a newline can be read.
 	bool getLine(std::string &line);
@@ -41,10 +70,29 @@ public:
 	// Returns false in case connection closed before null can be read.
 	bool getFrameAscii(std::string &frame, char delimiter);
 
+	// Get every complete frame received so far, blocking until there is at least one.
+	// Bytes already waiting on the socket are read first, so a batch holds as much of
+	// the backlog as possible. Returns false in case connection closed first.
+	// receivedAt, if given, gets the kernel receive time of each frame (a default
+	// time_point without receive timestamps).
+	bool getFrames(std::vector<std::string> &frames, char delimiter,
+	               std::vector<std::chrono::system_clock::time_point> *receivedAt = nullptr);
+
+	// Have the kernel timestamp received data, after connect()
+	bool enableReceiveTimestamps();
+
 	// Send a message to the remote host.
 	// Returns false in case connection is closed before all the data is sent.
 	bool sendFrameAscii(const std::string &frame, char delimiter);
 
+	// When bytes were last received from / sent to the remote host
+	std::chrono::steady_clock::time_point lastReadAt() const;
+	std::chrono::steady_clock::time_point lastWriteAt() const;
+
+	// Stop both directions without closing, waking a reader blocked on the socket;
+	// safe to call from another thread
+	void shutdown();
+
 	// Close down the connection properly.
 	void close();
 
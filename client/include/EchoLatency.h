@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../include/Histogram.h"
+#include "../include/Frame.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+// Publish-to-deliver latency per channel, measured on the broker's echoes of our own SENDs.
+// stamp() adds a monotonic send time (send-ts, microseconds) and a per-channel sequence
+// number (send-seq) to an outgoing SEND; onEcho() records the round trip when the echo
+// comes back. With a kernel receive time, the round trip is split into network time (send
+// to kernel receive) and client time (kernel receive to handling). Sequence numbers an
+// echo skips over are counted as missing until they show up.
+class EchoLatency {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Channel {
+        Histogram roundTrip;
+        Histogram network;
+        Histogram client;
+        uint64_t nextSequence;
+        uint64_t echoes;
+        uint64_t expectedSequence;
+        uint64_t missing;
+
+        Channel();
+    };
+
+    std::mutex mtx;
+    std::map<std::string, std::unique_ptr<Channel>> channels;
+
+    // Caller holds mtx
+    Channel& channel(const std::string& destination);
+
+public:
+    EchoLatency();
+    EchoLatency(const EchoLatency&) = delete;
+    EchoLatency& operator=(const EchoLatency&) = delete;
+
+    // frame must have its destination header
+    void stamp(Frame& frame);
+    // frameStr is a raw MESSAGE echoing one of our SENDs. kernelReceived is when the kernel
+    // received it, or a default time_point when unknown. Echoes without send-ts are ignored.
+    void onEcho(const std::string& frameStr, std::chrono::system_clock::time_point kernelReceived);
+
+    void print(std::ostream& out);
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <map>
+#include <cstdint>
 
 class Frame {
 private:
@@ -24,4 +25,13 @@ public:
     // Conversion methods
     std::string toString() const;
     static Frame parse(const std::string& msg);
+    
+    // Read the command / one header of a raw frame without parsing the rest
+    static std::string peekCommand(const std::string& msg);
+    static std::string peekHeader(const std::string& msg, const std::string& key);
+    // Index where the body of a raw frame starts (msg.size() if there is none)
+    static size_t peekBodyOffset(const std::string& msg);
+    // A numeric header of a raw frame, read in place without allocating; false if the
+    // header is missing or not a number
+    static bool peekNumber(const std::string& msg, const char* key, uint64_t& value);
 };
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../include/Frame.h"
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+
+// Per-frame body compression, marked on the frame itself: a SEND body of at least
+// threshold bytes goes out LZ4-compressed with "content-encoding:lz4", if that makes it
+// smaller, and a MESSAGE carrying the header is decompressed before it is handled.
+// An lz4 body is the uncompressed size (4 bytes, little endian) followed by one LZ4
+// block, the layout of the reference library's size-prefixed blocks. Such a body is
+// binary, so it always travels with content-length.
+// Stats keep the CPU time spent per frame in each direction, on the thread doing it.
+class FrameCompression {
+public:
+    enum class Result {
+        PLAIN,      // no content-encoding: use the frame as received
+        DECODED,    // decompressed into the output frame
+        FAILED      // unknown encoding or corrupt body
+    };
+
+    static const char* const ENCODING;
+    // Larger claimed sizes are rejected before allocating
+    static const size_t MAX_BODY_SIZE = 16 * 1024 * 1024;
+
+private:
+    std::atomic<bool> enabled;
+    std::atomic<size_t> threshold;
+
+    // Outbound: bodies tried, and those sent compressed
+    std::atomic<uint64_t> attempts;
+    std::atomic<uint64_t> compressed;
+    std::atomic<uint64_t> plainBytesOut;
+    std::atomic<uint64_t> encodedBytesOut;
+    std::atomic<uint64_t> compressNs;
+    // Inbound
+    std::atomic<uint64_t> decompressed;
+    std::atomic<uint64_t> encodedBytesIn;
+    std::atomic<uint64_t> plainBytesIn;
+    std::atomic<uint64_t> decompressNs;
+    std::atomic<uint64_t> failures;
+
+public:
+    FrameCompression();
+    FrameCompression(const FrameCompression&) = delete;
+    FrameCompression& operator=(const FrameCompression&) = delete;
+
+    // Off by default: a peer that doesn't know the header would take the bytes as text
+    void setEnabled(bool on);
+    bool isEnabled() const;
+    void setThreshold(size_t bytes);
+
+    // Compress the body of an outgoing frame in place, adding content-encoding and
+    // content-length. Returns false (frame untouched) when off, below the threshold,
+    // or when compression doesn't pay.
+    bool encode(Frame& frame);
+    // A raw received frame. If its body is encoded, decoded becomes the same frame with
+    // the body decompressed and without the content-encoding and content-length headers.
+    Result decode(const std::string& frameStr, std::string& decoded);
+
+    void printStats(std::ostream& out);
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "../include/event.h"
+#include "../include/InvertedIndex.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <limits>
+#include <iostream>
+
+// Interns repeated strings (event names, stat keys and values) into dense ids
+class StringPool {
+private:
+    std::unordered_map<std::string, uint32_t> ids;
+    // Points at the keys of ids, which never move
+    std::vector<const std::string*> strings;
+
+public:
+    StringPool();
+    // The copy's strings point at its own keys
+    StringPool(const StringPool& other);
+    StringPool& operator=(const StringPool&) = delete;
+
+    uint32_t intern(const std::string& value);
+    // Looks a string up without interning it
+    bool find(const std::string& value, uint32_t& id) const;
+    const std::string& get(uint32_t id) const;
+    size_t size() const;
+    size_t memoryBytes() const;
+};
+
+enum class StatScope : uint8_t {
+    GENERAL,
+    TEAM_A,
+    TEAM_B
+};
+
+// One "key:value" line of an event's general / team a / team b updates
+struct StatUpdate {
+    uint32_t key;
+    uint32_t value;
+    StatScope scope;
+};
+
+// Latest value of every stat, kept current as events arrive.
+// "Latest" is by event time, so a late-arriving older event never overrides a newer value;
+// events with equal times resolve in arrival order.
+class StatAggregates {
+private:
+    struct Latest {
+        int32_t time;
+        uint32_t value;
+    };
+
+    std::unordered_map<uint32_t, Latest> latest[3];
+    // Key ids of each scope ordered by key text, maintained on insert so output needs no sort
+    std::vector<uint32_t> sortedKeys[3];
+
+public:
+    StatAggregates();
+
+    void apply(const StatUpdate& update, int time, const StringPool& pool);
+    // Fold in another stream's latest values; on equal times the other's values win
+    void merge(const StatAggregates& other, const StringPool& pool);
+    // Append "key: value" lines of one scope, sorted by key
+    void appendStats(StatScope scope, const StringPool& pool, std::string& out) const;
+    size_t statCount() const;
+    size_t memoryBytes() const;
+};
+
+// The events one user reported for one game, stored column by column so that
+// scanning a game walks a few contiguous arrays instead of chasing Event objects.
+// Aggregates and a time-ordered index are updated on every append. Every K events (in time
+// order) a copy of the aggregates is kept as a checkpoint, so the stats as of any time are
+// rebuilt by replaying at most K - 1 events.
+class EventStream {
+private:
+    std::vector<int32_t> times;
+    std::vector<uint32_t> nameIds;
+    // n + 1 offsets into descriptions; event i is [offsets[i], offsets[i + 1])
+    std::vector<uint64_t> descriptionOffsets;
+    std::string descriptions;
+    // n + 1 offsets into updates (the update-delta column)
+    std::vector<uint32_t> updateOffsets;
+    std::vector<StatUpdate> updates;
+
+    // Event indexes sorted by time, ties in arrival order; byName and byStat hold the
+    // events with a given name / updating a given stat key, in the same order
+    std::vector<uint32_t> byTime;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> byName;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> byStat;
+    StatAggregates aggregates;
+
+    // checkpoints[j] holds the aggregates of the first (j + 1) * K events of byTime; 0 disables
+    size_t checkpointInterval;
+    std::vector<StatAggregates> checkpoints;
+
+    // Insert event i into a time-ordered index, returning its position
+    size_t insertByTime(std::vector<uint32_t>& index, uint32_t i);
+    void applyEvent(StatAggregates& target, uint32_t i, const StringPool& pool) const;
+    // Drop the checkpoints covering byTime positions from `position` on and rebuild them
+    void rebuildCheckpoints(size_t position, const StringPool& pool);
+
+public:
+    EventStream();
+
+    void append(const Event& event, StringPool& pool);
+
+    size_t size() const;
+    int time(size_t i) const;
+    uint32_t nameId(size_t i) const;
+    void appendDescription(size_t i, std::string& out) const;
+    const char* descriptionData(size_t i) const;
+    size_t descriptionLength(size_t i) const;
+    const StatUpdate* updatesBegin(size_t i) const;
+    const StatUpdate* updatesEnd(size_t i) const;
+
+    const std::vector<uint32_t>& timeOrder() const;
+    const StatAggregates& stats() const;
+
+    // Time-ordered events with the given name / updating the given stat key, or nullptr
+    const std::vector<uint32_t>* eventsNamed(uint32_t nameId) const;
+    const std::vector<uint32_t>* eventsWithStat(uint32_t keyId) const;
+    // [begin, end) positions of a time-ordered index whose events have from <= time <= to
+    void timeRange(const std::vector<uint32_t>& index, int from, int to, size_t& begin, size_t& end) const;
+
+    // Number of events with time <= t, i.e. the length of the timeOrder() prefix up to t
+    size_t countUntil(int t) const;
+    // Aggregates of the first `count` events in time order, from the nearest checkpoint
+    StatAggregates statsOf(size_t count, const StringPool& pool) const;
+
+    void setCheckpointInterval(size_t interval, const StringPool& pool);
+    size_t memoryBytes() const;
+    size_t checkpointMemoryBytes() const;
+};
+
+// Filter of GameEventStore::query; empty strings match everything, the time range starts open
+struct EventQuery {
+    std::string game;
+    std::string user;
+    int from;
+    int to;
+    std::string eventName;
+    std::string statKey;
+
+    EventQuery() : game(), user(), from(std::numeric_limits<int>::min()), to(std::numeric_limits<int>::max()),
+                   eventName(), statKey() {}
+};
+
+// All stored events, per game and per reporting user.
+// Not synchronized; see ShardedEventStore, which copies a store before changing it
+// while a reader still holds it.
+class GameEventStore {
+private:
+    // One stored event, as a search result id. Stream nodes never move.
+    struct EventRef {
+        const std::string* user;
+        const EventStream* stream;
+        uint32_t event;
+    };
+
+    struct Game {
+        std::string team_a_name;
+        std::string team_b_name;
+        std::map<std::string, EventStream> streams;
+        // Descriptions, indexed by position in events (arrival order across users)
+        InvertedIndex text;
+        std::vector<EventRef> events;
+
+        Game() : team_a_name(), team_b_name(), streams(), text(), events() {}
+        // The copy's refs point into its own streams
+        Game(const Game& other);
+        Game& operator=(const Game&) = delete;
+    };
+
+    StringPool pool;
+    std::map<std::string, Game> games;
+    size_t checkpointInterval;
+
+    void render(const Game& g, const EventStream& stream, const StatAggregates& stats,
+                size_t count, std::string& out) const;
+    const EventStream* findStream(const std::string& game, const std::string& user, const Game*& g) const;
+
+public:
+    GameEventStore();
+
+    void add(const std::string& game, const std::string& user, const Event& event);
+
+    bool hasGame(const std::string& game) const;
+    bool hasStream(const std::string& game, const std::string& user) const;
+
+    // Render the summary report of user's events in game (stats, then events by time),
+    // in O(stats + output). Returns false if there is no such stream.
+    bool summarize(const std::string& game, const std::string& user, std::string& out) const;
+    // The same report as of `time`: stats and events with time <= `time`
+    bool summarizeAt(const std::string& game, const std::string& user, int time, std::string& out) const;
+    // The report over every user's events with time <= `time`, k-way merged by time and
+    // written straight to out. Events reported by several users (same time, name and
+    // description) appear once; duplicates counts the collapsed copies.
+    bool summarizeMerged(const std::string& game, int time, std::ostream& out, size_t& duplicates) const;
+
+    // Render the events matching q, ordered by time, and count them.
+    // Returns false if the game (or the given user in it) is unknown.
+    bool query(const EventQuery& q, std::string& out, size_t& matches) const;
+
+    // Render the events of game (or of every game, for "*") whose descriptions contain all
+    // words (or, with any, at least one), one line each, by game and time.
+    // Returns false if the game is unknown.
+    bool search(const std::string& game, const std::vector<std::string>& words, bool any,
+                std::string& out, size_t& matches) const;
+
+    // Events between aggregate checkpoints (0 disables checkpoints); applies to every stream
+    void setCheckpointInterval(size_t interval);
+
+    size_t eventCount() const;
+    size_t memoryBytes() const;
+    size_t checkpointMemoryBytes() const;
+    size_t textIndexMemoryBytes() const;
+    size_t searchTermCount() const;
+    size_t searchPostingCount() const;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../include/TimerWheel.h"
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+// STOMP 1.2 heart-beating for one connection, on a TimerWheel (normally the shared one).
+// The outbound timer sends a beat whenever nothing else was written for a send interval;
+// the inbound timer gives up on the peer after twice the expected interval without a
+// byte from it. Each timer re-arms itself for the next moment it could have to act, so
+// a busy connection costs one timer callback per interval in each direction.
+class HeartBeat {
+public:
+    typedef TimerWheel::Clock Clock;
+    typedef std::function<Clock::time_point()> ActivityProbe;
+
+private:
+    TimerWheel& wheel;
+    // Guards the fields below; timer callbacks re-arm under it, so stop() can't miss one
+    std::mutex mtx;
+    bool running;
+    TimerWheel::TimerId sendTimer;
+    TimerWheel::TimerId checkTimer;
+    Clock::duration sendEvery;
+    Clock::duration expectEvery;
+    ActivityProbe lastSent;
+    ActivityProbe lastReceived;
+    std::function<bool()> sendBeat;
+    std::function<void()> onTimeout;
+    std::atomic<uint64_t> beatsSent;
+    std::atomic<uint64_t> timeouts;
+
+    // Caller holds mtx
+    void armSend(Clock::time_point at);
+    void armCheck(Clock::time_point at);
+    void onSendTimer();
+    void onCheckTimer();
+
+public:
+    explicit HeartBeat(TimerWheel& wheel = TimerWheel::shared());
+    ~HeartBeat();
+    HeartBeat(const HeartBeat&) = delete;
+    HeartBeat& operator=(const HeartBeat&) = delete;
+
+    // Parse a "cx,cy" heart-beat header; false if malformed
+    static bool parse(const std::string& header, uint64_t& first, uint64_t& second);
+    // Intervals agreed from our header (cx,cy) and the peer's (sx,sy), in milliseconds:
+    // we send every sendMs and expect the peer every expectMs (0 = not in that direction)
+    static void negotiate(uint64_t cx, uint64_t cy, uint64_t sx, uint64_t sy, uint64_t& sendMs, uint64_t& expectMs);
+
+    // Replaces any previous session. lastSent/lastReceived report the connection's
+    // latest write and read, and are called under the lock; sendBeat writes one EOL if
+    // it can without blocking and returns whether it did; onTimeout is called once, on
+    // the timer thread, when the peer went silent. Neither is called under the lock.
+    void start(uint64_t sendMs, uint64_t expectMs, ActivityProbe lastSent, ActivityProbe lastReceived,
+               std::function<bool()> sendBeat, std::function<void()> onTimeout);
+    // Cancels both timers; a callback already running finishes first
+    void stop();
+
+    void printStats(std::ostream& out);
+};
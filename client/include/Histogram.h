@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <iostream>
+
+// Log-linear histogram of non-negative integer samples (HdrHistogram-style buckets:
+// 32 linear sub-buckets per power of two, so every value is kept to within ~3%).
+// record() is lock-free and allocation-free, so it can run on hot paths.
+class Histogram {
+private:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    std::atomic<uint64_t> counts[BUCKET_COUNT];
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> minValue;
+    std::atomic<uint64_t> maxValue;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketLow(int index);
+    static uint64_t bucketHigh(int index);
+
+public:
+    Histogram();
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const;
+    uint64_t min() const;
+    uint64_t max() const;
+    double mean() const;
+    // Highest value equivalent to the given percentile (0-100)
+    uint64_t percentile(double p) const;
+
+    // Percentiles followed by a power-of-two distribution
+    void print(std::ostream& out, const std::string& title, const std::string& unit) const;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+// Hands raw inbound frames to a pool of worker threads, partitioned by a key (the
+// destination): frames with the same key run on the same worker, in dispatch order,
+// while different keys are handled in parallel. With 0 workers frames run inline on
+// the dispatching thread.
+// Load shedding: each key (channel) has an optional token-bucket rate limit, and each
+// worker queue an optional bound. A frame over either budget is handled by the policy:
+// drop the newest frame, drop the oldest queued one, or keep every Nth frame. A shed
+// frame goes to the drop handler, if any, on the dispatching thread.
+class InboundDispatcher {
+public:
+    typedef std::function<void(const std::string& frame)> Handler;
+    typedef std::chrono::steady_clock Clock;
+
+    // Per-channel state, kept for the dispatcher's lifetime; resolved once with
+    // channel(), a dispatch needs no lookup by key
+    struct Channel {
+        // Picks the worker
+        size_t hash;
+        // Token bucket, refilled continuously up to one second's worth
+        double tokens;
+        Clock::time_point refilledAt;
+        uint64_t received;
+        uint64_t dropped;
+        // Frames over budget so far, for KEEP_EVERY_NTH
+        uint64_t overBudget;
+
+        Channel();
+    };
+
+private:
+
+    enum class Policy { DROP_NEWEST, DROP_OLDEST, KEEP_EVERY_NTH };
+
+    struct Queued {
+        Channel* channel;
+        std::string frame;
+    };
+
+    struct Worker {
+        std::mutex mtx;
+        std::condition_variable ready;   // frames queued, or stopping
+        std::condition_variable idle;    // queue drained
+        std::deque<Queued> queue;
+        bool busy;
+        bool stopping;
+        size_t maxDepth;
+        std::atomic<uint64_t> processed;
+        // For the rate shown by printStats
+        uint64_t reportedProcessed;
+        std::thread thread;
+
+        Worker();
+    };
+
+    Handler handler;
+    Handler dropHandler;
+    // Guards workers against setWorkers() while frames are dispatched, and the
+    // channels and limits below
+    std::mutex poolMtx;
+    std::vector<std::unique_ptr<Worker>> workers;
+    Clock::time_point reportedAt;
+    // Hashed: thousands of subscribed channels are looked up on every frame
+    std::unordered_map<std::string, Channel> channels;
+    double rateLimit;      // frames per second per channel, 0 = unlimited
+    size_t queueLimit;     // frames per worker queue, 0 = unbounded
+    Policy policy;
+    size_t keepEvery;
+
+    // Caller holds poolMtx
+    Channel& findChannel(const std::string& key, Clock::time_point now);
+    // Returns whether a frame (this one or a queued one) was shed, moved into shed
+    bool dispatchLocked(Channel& channel, std::string&& frame, Clock::time_point now, std::string& shed);
+    // Caller holds poolMtx. Whether channel may take one more frame at the rate limit
+    bool takeToken(Channel& channel, Clock::time_point now);
+    // Caller holds poolMtx and worker.mtx. Removes the oldest queued frame of channel
+    // (of any channel if null) into shed; false if there is none
+    bool dropOldest(Worker& worker, Channel* channel, std::string& shed);
+    std::string policyName() const;
+
+    void run(Worker& worker);
+    // Caller holds poolMtx
+    void startWorkers(size_t count);
+    void stopWorkers();
+
+public:
+    InboundDispatcher(Handler handler, size_t workerCount, Handler dropHandler = Handler());
+    ~InboundDispatcher();
+    InboundDispatcher(const InboundDispatcher&) = delete;
+    InboundDispatcher& operator=(const InboundDispatcher&) = delete;
+
+    // Finishes the queued frames, then restarts with count workers
+    void setWorkers(size_t count);
+    // 0 turns the limit off
+    void setRateLimit(double framesPerSecond);
+    void setQueueLimit(size_t frames);
+    // "drop-newest", "drop-oldest" or "keep-every-N"; throws std::invalid_argument otherwise
+    void setPolicy(const std::string& name);
+
+    // Creates the channel on first use; the pointer stays valid
+    Channel* channel(const std::string& key);
+    void dispatch(const std::string& key, std::string&& frame);
+    void dispatch(Channel* channel, std::string&& frame);
+    // Wait until every frame dispatched so far has been handled
+    void flush();
+
+    void printStats(std::ostream& out);
+};
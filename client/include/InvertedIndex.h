@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Full-text index from terms to the ids of the documents containing them.
+// Documents must be added with increasing ids, so every posting list is append-only:
+// ids are stored as varint-encoded deltas, with a skip entry every SKIP_INTERVAL postings
+// that lets AND intersections jump over runs of a long list.
+// Terms are maximal runs of ASCII letters/digits and non-ASCII bytes (UTF-8 names stay
+// whole), lowercased.
+class InvertedIndex {
+private:
+    static const uint32_t SKIP_INTERVAL = 128;
+
+    struct Skip {
+        uint32_t id;       // last id before the skipped-to block
+        uint32_t offset;   // byte offset of the block
+    };
+
+    struct PostingList {
+        std::vector<uint8_t> bytes;
+        std::vector<Skip> skips;
+        uint32_t count;
+        uint32_t last;
+
+        PostingList() : bytes(), skips(), count(0), last(0) {}
+    };
+
+    // Forward reader over one posting list
+    class Cursor {
+    private:
+        const PostingList* list;
+        size_t offset;
+        uint32_t read;
+        uint32_t current;
+
+    public:
+        explicit Cursor(const PostingList* list);
+        Cursor(const Cursor&) = default;
+        Cursor& operator=(const Cursor&) = default;
+
+        bool valid() const;
+        uint32_t id() const;
+        void next();
+        // Move to the first id >= target
+        void advanceTo(uint32_t target);
+    };
+
+    std::unordered_map<std::string, PostingList> terms;
+    size_t postings;
+
+public:
+    InvertedIndex();
+
+    static void tokenize(const std::string& text, std::vector<std::string>& out);
+
+    void add(uint32_t id, const std::string& text);
+
+    // Ids of the documents containing every term (or, with any, at least one term), ascending
+    std::vector<uint32_t> search(const std::vector<std::string>& words, bool any) const;
+
+    size_t termCount() const;
+    size_t postingCount() const;
+    size_t memoryBytes() const;
+};
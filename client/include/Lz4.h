@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+// The LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md),
+// enough of it for frame bodies: a greedy single-pass compressor with a small hash table,
+// and a decompressor that checks every length and offset against both buffers, so a
+// corrupt or hostile block fails instead of reading or writing out of bounds.
+// Blocks are interchangeable with those of the reference library.
+class Lz4 {
+public:
+    // Largest block compress() can produce for size input bytes
+    static size_t compressBound(size_t size);
+    // Replaces out with the compressed block
+    static void compress(const char* src, size_t size, std::string& out);
+    // Decompresses a whole block into exactly dstSize bytes; false if the block is
+    // malformed or doesn't decompress to dstSize
+    static bool decompress(const char* src, size_t size, char* dst, size_t dstSize);
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <mutex>
+#include <cstdint>
+#include <iostream>
+
+// The serialized form of a reported file: team names and one SEND body per event.
+// Bodies are stored without the leading "user:" line so a cached report can be
+// re-sent by whichever user is logged in.
+struct CachedReport {
+    std::string team_a_name;
+    std::string team_b_name;
+    std::vector<std::string> bodies;
+
+    CachedReport() : team_a_name(), team_b_name(), bodies() {}
+};
+
+// Identity of a report file on disk
+struct ReportKey {
+    std::string path;
+    long long size;
+    long long mtime;
+    uint64_t hash;
+
+    ReportKey() : path(), size(0), mtime(0), hash(0) {}
+    ReportKey(const std::string& path, long long size, long long mtime, uint64_t hash) :
+        path(path), size(size), mtime(mtime), hash(hash) {}
+};
+
+// Client-side cache of serialized reports, so submitting the same file again skips JSON parsing.
+// Entries live in memory up to a byte budget; least recently used entries are evicted,
+// or written to a spill directory when one is configured.
+class ReportCache {
+private:
+    struct Entry {
+        ReportKey key;
+        CachedReport report;
+        size_t bytes;
+    };
+
+    size_t memoryBudget;
+    size_t memoryUsed;
+    std::string spillDir;
+
+    // Most recently used entry at the front
+    std::list<Entry> lru;
+    std::map<std::string, std::list<Entry>::iterator> byPath;
+    // Spilled entries: path -> (key, spill file). A path is either here or in lru, never both.
+    std::map<std::string, std::pair<ReportKey, std::string>> spilled;
+
+    unsigned long hits;
+    unsigned long spillHits;
+    unsigned long misses;
+    unsigned long evictions;
+    unsigned long spills;
+
+    mutable std::mutex mtx;
+
+    static size_t sizeOf(const CachedReport& report);
+    static bool sameKey(const ReportKey& a, const ReportKey& b);
+    void insertFront(const ReportKey& key, const CachedReport& report);
+    void evictToBudget();
+    // Named by both path and content hash, so equal files at two paths don't share one
+    bool writeSpill(const Entry& entry, std::string& spillPath);
+    // Drop path's spill entry and its file, if any
+    void removeSpill(const std::string& path);
+    static bool readSpill(const std::string& spillPath, CachedReport& out);
+
+public:
+    ReportCache();
+
+    // Build the key of a file (size, mtime and FNV-1a content hash). Returns false if it can't be read.
+    static bool makeKey(const std::string& path, ReportKey& key);
+
+    // Returns true and fills out when an entry matching key is cached
+    bool lookup(const ReportKey& key, CachedReport& out);
+    void store(const ReportKey& key, const CachedReport& report);
+
+    void setMemoryBudget(size_t bytes);
+    // Empty dir disables spilling
+    void setSpillDirectory(const std::string& dir);
+
+    void printStats(std::ostream& out) const;
+};
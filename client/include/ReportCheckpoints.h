@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <cstdint>
+
+// Persistent record of how many events of each report file the server has acknowledged,
+// so an interrupted report can resume instead of re-sending the whole file.
+// Stored as one line per file: "<acked events> <content hash> <path>".
+class ReportCheckpoints {
+private:
+    struct Checkpoint {
+        uint64_t hash;
+        size_t acked;
+    };
+
+    std::string checkpointPath;
+    std::map<std::string, Checkpoint> checkpoints;
+    bool loaded;
+    std::mutex mtx;
+
+    void loadLocked();
+    void saveLocked();
+
+public:
+    ReportCheckpoints();
+
+    void setPath(const std::string& path);
+
+    // Events of file already acknowledged; 0 if unknown or the file content changed
+    size_t acknowledged(const std::string& file, uint64_t hash);
+    // Record that the first acked events of file were acknowledged
+    void record(const std::string& file, uint64_t hash, size_t acked);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../include/event.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <functional>
+
+// Follows growing JSON Lines event files (see parseEventsHeaderLine) with inotify.
+// A single thread watches every followed file; on each write it reads only the
+// bytes appended since the last read and hands every completed event line to the callback.
+// The callback runs without the lock held, so it may block without stalling follow/unfollow.
+class ReportFollower {
+public:
+    typedef std::function<void(const std::string& team_a_name, const std::string& team_b_name, const Event& event)> EventCallback;
+
+private:
+    struct FollowedFile {
+        std::string path;
+        int fd;
+        long long offset;
+        // Bytes of a line whose newline has not been written yet
+        std::string partial;
+        bool hasHeader;
+        std::string team_a_name;
+        std::string team_b_name;
+
+        FollowedFile(const std::string& path, int fd) :
+            path(path), fd(fd), offset(0), partial(), hasHeader(false), team_a_name(), team_b_name() {}
+    };
+
+    // An event parsed under the lock, handed to the callback once it is released
+    struct ReadyEvent {
+        std::string team_a_name;
+        std::string team_b_name;
+        Event event;
+
+        ReadyEvent(const std::string& team_a_name, const std::string& team_b_name, const Event& event) :
+            team_a_name(team_a_name), team_b_name(team_b_name), event(event) {}
+    };
+
+    EventCallback onEvent;
+    int inotifyFd;
+    // Wakes the thread when files are added or it must stop
+    int wakeFd;
+    std::map<int, FollowedFile> files;
+    bool stopping;
+
+    std::mutex mtx;
+    std::thread worker;
+
+    void run();
+    void readAppended(FollowedFile& file, std::vector<ReadyEvent>& ready);
+    void processLine(FollowedFile& file, const std::string& line, std::vector<ReadyEvent>& ready);
+    void wake();
+
+public:
+    explicit ReportFollower(EventCallback callback);
+    ~ReportFollower();
+    ReportFollower(const ReportFollower&) = delete;
+    ReportFollower& operator=(const ReportFollower&) = delete;
+
+    // Returns false with a reason if the file can't be followed, or is already followed
+    // (under this path or another one naming the same file)
+    bool follow(const std::string& path, std::string& error);
+    bool unfollow(const std::string& path);
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+// Persistent list of the channels each user is subscribed to, so a new session can
+// restore them along with its CONNECT instead of re-joining by hand.
+// Stored as one line per subscription: "<user> <channel>", in join order.
+class SavedSubscriptions {
+private:
+    std::string savedPath;
+    std::map<std::string, std::vector<std::string>> channels;
+    bool loaded;
+    std::mutex mtx;
+
+    void loadLocked();
+    void saveLocked();
+
+public:
+    SavedSubscriptions();
+
+    void setPath(const std::string& path);
+
+    // Channels saved for user, in join order
+    std::vector<std::string> load(const std::string& user);
+    // Replace user's saved channels
+    void save(const std::string& user, const std::vector<std::string>& userChannels);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../include/Histogram.h"
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+// Receipt-based credit window for outbound SEND streams.
+// A receipt is requested every K frames; at most `window` frames may be unacknowledged,
+// and senders block in acquire() once that many are in flight. Receipts arrive in send
+// order, so one receipt acknowledges every frame sent before it. The window grows while
+// receipt round trips stay near the best seen and shrinks when they stretch, i.e. when
+// the broker stops keeping up.
+class SendWindow {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct PendingReceipt {
+        uint64_t seq;
+        Clock::time_point sentAt;
+
+        PendingReceipt(uint64_t seq, Clock::time_point sentAt) : seq(seq), sentAt(sentAt) {}
+    };
+
+    bool enabled;
+    bool closed;
+    size_t receiptEvery;
+    size_t window;
+    size_t minWindow;
+    size_t maxWindow;
+
+    uint64_t sentSeq;
+    uint64_t ackedSeq;
+    size_t sinceReceipt;
+    std::map<int, PendingReceipt> pending;
+
+    // Round trips in microseconds
+    double smoothedRtt;
+    double minRtt;
+    Histogram receiptLatency;
+
+    std::mutex mtx;
+    std::condition_variable acked;
+
+    void adapt(double rtt);
+
+public:
+    SendWindow();
+
+    // 0 disables flow control
+    void setWindow(size_t initialWindow);
+    void setReceiptEvery(size_t frames);
+
+    // Wait for room for one more frame. Returns false if the window was closed meanwhile.
+    // wantReceipt tells the caller to request a receipt on this frame and pass its id to track().
+    bool acquire(bool& wantReceipt);
+    void track(int receiptId);
+    // Returns true if the receipt belonged to the window
+    bool onReceipt(int receiptId);
+
+    // Release blocked senders (disconnect) / start over (new connection)
+    void close();
+    void reset();
+
+    void printStats(std::ostream& out);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../include/GameEventStore.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <iostream>
+
+// Thread-safe event storage, one independently locked shard per game.
+// Ingest never waits for readers: add() appends to the shard's pending list under a
+// short lock, and the pending events are folded into the shard's GameEventStore by the
+// next reader (or by add() itself, when the list is long).
+// Readers run on a snapshot: the store is held by shared_ptr, a reader takes a reference
+// under the lock and releases the lock before reading, and a fold copies the store first
+// if a reader still holds it. A long summary of one game therefore delays neither stores
+// into that game, folds of them, nor anything touching other games.
+// The game directory is copy-on-write: lookups load the current map without locking,
+// and a new game publishes a new map.
+// addRaw() defers decoding as well: the event body is appended to the shard's byte arena
+// as received and only parsed into an Event when a reader folds that game.
+class ShardedEventStore {
+private:
+    // add() folds on its own past this many pending events, if the store is free
+    static const size_t FOLD_THRESHOLD = 1024;
+
+    struct PendingEvent {
+        std::string user;
+        // Null for a raw event, whose body is rawBodies[rawOffset, rawOffset + rawLength)
+        std::unique_ptr<Event> event;
+        size_t rawOffset;
+        size_t rawLength;
+    };
+
+    struct Shard {
+        const std::string game;
+
+        // Guards the store pointer; the store it points at is never changed once a reader holds it
+        std::mutex storeMtx;
+        std::shared_ptr<GameEventStore> store;
+
+        std::mutex pendingMtx;
+        std::vector<PendingEvent> pending;
+        // Append-only until the next fold
+        std::string rawBodies;
+        size_t rawCount;
+
+        explicit Shard(const std::string& game);
+    };
+
+    typedef std::map<std::string, std::shared_ptr<Shard>> Directory;
+
+    // Read with std::atomic_load, replaced with std::atomic_store under directoryMtx
+    std::shared_ptr<const Directory> directory;
+    std::mutex directoryMtx;
+    std::atomic<size_t> checkpointInterval;
+
+    std::shared_ptr<Shard> findShard(const std::string& game) const;
+    std::shared_ptr<Shard> getOrCreateShard(const std::string& game);
+    // Caller holds shard.storeMtx
+    static GameEventStore& writableStore(Shard& shard);
+    static std::shared_ptr<const GameEventStore> fold(Shard& shard);
+
+public:
+    ShardedEventStore();
+    ShardedEventStore(const ShardedEventStore&) = delete;
+    ShardedEventStore& operator=(const ShardedEventStore&) = delete;
+
+    void add(const std::string& game, const std::string& user, const Event& event);
+    // Store an event body without decoding it; it is parsed when a reader touches the game
+    void addRaw(const std::string& game, const std::string& user, const char* body, size_t length);
+
+    bool hasGame(const std::string& game) const;
+
+    // Run reader on game's store, with every event added so far visible. The reader runs
+    // without the shard's lock, on a snapshot later events don't change.
+    // Returns false (without calling reader) if the game is unknown.
+    bool read(const std::string& game, const std::function<void(const GameEventStore&)>& reader);
+    // Run reader on every game's store, in game name order
+    void readAll(const std::function<void(const std::string&, const GameEventStore&)>& reader);
+
+    void setCheckpointInterval(size_t interval);
+    void printStats(std::ostream& out);
+};
@@ -3,10 +3,26 @@
 #include "../include/ConnectionHandler.h"
 #include "../include/Frame.h"
 #include "../include/event.h"
+#include "../include/ShardedEventStore.h"
+#include "../include/ReportCache.h"
+#include "../include/ReportCheckpoints.h"
+#include "../include/Histogram.h"
+#include "../include/TimerWheel.h"
+#include "../include/SendWindow.h"
+#include "../include/ReportFollower.h"
+#include "../include/InboundDispatcher.h"
+#include "../include/EchoLatency.h"
+#include "../include/SubscriptionMonitor.h"
+#include "../include/SavedSubscriptions.h"
+#include "../include/HeartBeat.h"
+#include "../include/AckBatcher.h"
+#include "../include/FrameCompression.h"
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
+#include <atomic>
 
 enum class UserCommand {
     LOGIN,
@@ -15,9 +31,27 @@ enum class UserCommand {
     LOGOUT,
     REPORT,
     SUMMARY,
+    QUERY,
+    SEARCH,
+    LATENCY,
+    CONFIG,
+    STATS,
     UNKNOWN
 };
 
+// Receipt requested on a report SEND: once it arrives, the first acked events of file are known delivered
+struct ReportReceipt {
+    std::string file;
+    uint64_t hash;
+    size_t acked;
+    // Whether the receipt advances the checkpoint file, or only the send window
+    bool checkpoint;
+
+    ReportReceipt() : file(), hash(0), acked(0), checkpoint(false) {}
+    ReportReceipt(const std::string& file, uint64_t hash, size_t acked, bool checkpoint) :
+        file(file), hash(hash), acked(acked), checkpoint(checkpoint) {}
+};
+
 enum class ServerCommand {
     CONNECTED,
     ERROR,
@@ -30,23 +64,109 @@ class StompProtocol
 {
 private:
     ConnectionHandler* handler;
+    
+    // Connection state, guarded by stateMtx
     bool shouldTerminate;
     bool isConnected;
-    
     std::string currentUserName;
+    // A report SEND asks for a receipt every this many events (0 disables checkpoints)
+    size_t checkpointInterval;
+    // Store received events undecoded, parsing them when a command reads the game
+    bool lazyDecoding;
+    // Random per login; our SENDs carry it in a header so their echoes are recognized
+    // without reading the body
+    std::string sessionMarker;
+    // Ask the kernel for receive timestamps on the next connection
+    bool kernelTimestamps;
+    // Heart-beat header of the next CONNECT, in milliseconds: how often we can send
+    // and how often we want to hear from the server (0,0 = off)
+    uint64_t heartBeatSendMs;
+    uint64_t heartBeatReceiveMs;
+    
+    // Guarded by subscriptionMtx
     int subscriptionIdCounter;
-    int receiptIdCounter;
+    std::unordered_map<std::string, int> subscriptions;
+    // CONNECT sent, no reply yet; subscriptions made meanwhile wait for it
+    bool connectPending;
+    std::vector<std::string> pendingSubscriptions;
+    // Written on each join and exit, read by login --restore
+    SavedSubscriptions savedSubscriptions;
     
-    std::map<std::string, int> subscriptions;
+    // Guarded by receiptMtx
+    int receiptIdCounter;
     std::map<int, std::string> receiptActions;
-    std::map<std::string, std::map<std::string, std::vector<Event>>> gameEvents;
+    std::map<int, ReportReceipt> reportReceipts;
+    
+    // Locks per game internally; storing a received event never waits for a summary
+    ShardedEventStore eventStore;
     
-    mutable std::mutex mtx;
+    ReportCache reportCache;
+    ReportCheckpoints reportCheckpoints;
+    // Scheduled-vs-actual send time of paced report events, in microseconds, over all reports
+    Histogram paceSkew;
+    SendWindow sendWindow;
+    std::atomic<uint64_t> selfEchoesDropped;
+    EchoLatency echoLatency;
+    SubscriptionMonitor subscriptionMonitor;
+    // SEND bodies out, MESSAGE bodies in (on the inbound workers)
+    FrameCompression compression;
+    
+    // Independent locks, never nested, so the socket thread only contends on what it touches
+    mutable std::mutex stateMtx;
+    std::mutex subscriptionMtx;
+    std::mutex receiptMtx;
+    // Serializes writes to the connection, which happen from the stdin and timer threads
+    std::mutex sendMtx;
+    
+    // Declared last so their threads stop (and no paced or followed send runs)
+    // before the members above are destroyed; acks outlives the inbound workers using it
+    AckBatcher acks;
+    TimerWheel paceTimers;
+    ReportFollower reportFollower;
+    InboundDispatcher inbound;
+    // On the shared wheel; beats only while no other frame is being written
+    HeartBeat heartBeat;
     
     std::vector<std::string> split(const std::string& str, char delimiter);
     UserCommand parseUserCommand(const std::string& cmd);
     ServerCommand parseServerCommand(const std::string& cmd);
     
+    // Serialize one event into a SEND body, without the leading "user:" line
+    static std::string buildEventBody(const Event& event, const std::string& team_a, const std::string& team_b);
+    // Load a report file through the report cache
+    bool loadReport(const std::string& file_path, CachedReport& report, ReportKey& key);
+    // Both take the waiting ACKs along in the same write
+    bool sendFrame(const Frame& frame);
+    // All frames in a single write
+    bool sendFrames(const std::vector<Frame>& frames);
+    // Write the waiting ACKs on their own
+    void flushAcks();
+    // A SEND of body to game_name, tagged with the session marker; compressed if enabled
+    Frame buildSendFrame(const std::string& game_name, const std::string& body);
+    // Send each event at its game time divided by speed, from the timer thread
+    void schedulePacedReport(const std::string& game_name, const std::string& userLine,
+                             const CachedReport& report, double speed);
+    // Called on the follower thread for every event appended to a followed file
+    void handleFollowedEvent(const std::string& team_a, const std::string& team_b, const Event& event);
+    std::string getCurrentUserName() const;
+    bool isDisconnectReceipt(const std::string& receiptId);
+    bool isSubscribed(const std::string& game_name);
+    bool isConnectPending();
+    // Register game_names as subscribed and append their SUBSCRIBE frames, the last one
+    // asking for a receipt announced as "<verb> N channels"
+    void subscribe(const std::vector<std::string>& game_names, const std::string& verb,
+                   std::vector<Frame>& frames, AckMode ackMode = AckMode::AUTO);
+    // Save the current subscriptions for the user, unless CONNECTED is still awaited
+    void saveSubscriptions();
+    // On CONNECTED (connected) or ERROR: commit or roll back the pending subscriptions
+    void settlePendingSubscriptions(bool connected);
+    // "/game" of the active subscription a raw MESSAGE was delivered on, or nullptr
+    const std::string* subscriptionOf(const std::string& frameStr) const;
+    // Start heart-beating as negotiated with the server's CONNECTED header
+    void startHeartBeat(const std::string& serverHeader);
+    // Runs on the inbound workers
+    void handleMessage(const std::string& received);
+    
     // Command handlers
     void handleLogin(const std::vector<std::string>& args);
     void handleJoin(const std::vector<std::string>& args);
@@ -54,12 +174,25 @@ private:
     void handleLogout();
     void handleReport(const std::vector<std::string>& args);
     void handleSummary(const std::vector<std::string>& args);
+    void summarizeAllUsers(const std::string& game_name, int time, const std::string& file_path);
+    void handleQuery(const std::vector<std::string>& args);
+    void handleSearch(const std::vector<std::string>& args);
+    void handleLatency(const std::vector<std::string>& args);
+    void handleConfig(const std::vector<std::string>& args);
+    void handleStats();
 
 public:
     StompProtocol();
     void setConnectionHandler(ConnectionHandler* h);
     
     void executeUserCommand(const std::string& line);
+    // Called by the socket thread with each batch of received frames, and their kernel
+    // receive times if known. Control frames (CONNECTED, RECEIPT) are handled first, then
+    // the MESSAGEs go to the inbound workers; a frame that ends the session (ERROR,
+    // DISCONNECT receipt) waits for the MESSAGEs before it. Returns false once the
+    // session is over.
+    bool receiveFrames(std::vector<std::string>& frames,
+                       const std::vector<std::chrono::system_clock::time_point>& receivedAt);
     bool handleServerFrame(const std::string& frameStr);
     
     void close();
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include "../include/InboundDispatcher.h"
+
+// Delivery health per subscription: message-id reordering and duplicates, gaps in the
+// broker's per-channel sequence (channel-seq), and consumer lag from the sender's send-ts.
+// The per-message paths take no lock and allocate nothing: slots are indexed by
+// subscription id in chunks allocated at join time, and hold relaxed atomic counters.
+// onReceived() is called from the socket thread only and onHandled() from the worker
+// owning the channel, so each counter has a single writer; stats only read them.
+// The same table routes inbound MESSAGEs: a subscription header maps to its channel and
+// its dispatcher state in O(1), however many subscriptions there are.
+//
+// send-ts is the sender's monotonic clock, so a delay computed from it carries an unknown
+// clock offset. The smallest delay seen on a subscription is taken as that offset plus
+// the network floor, and lag is how far a message's delay exceeds it.
+class SubscriptionMonitor {
+private:
+    static const size_t CHUNK_SIZE = 1024;
+    static const size_t MAX_CHUNKS = 1024;
+
+    struct Slot {
+        std::atomic<bool> active;
+        // Written before active is published
+        std::string destination;
+        InboundDispatcher::Channel* route;
+        std::atomic<uint64_t> messages;
+        std::atomic<uint64_t> lastMessageId;
+        std::atomic<uint64_t> reordered;
+        std::atomic<uint64_t> duplicates;
+        std::atomic<uint64_t> expectedSequence;   // 0 until the first channel-seq
+        std::atomic<uint64_t> missing;
+        std::atomic<uint64_t> handled;
+        std::atomic<int64_t> minDelay;
+        std::atomic<int64_t> lastLag;
+        std::atomic<int64_t> maxLag;
+
+        Slot();
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+    };
+
+    std::atomic<Slot*> chunks[MAX_CHUNKS];
+    // Serializes track() calls allocating chunks; never taken per message
+    std::mutex trackMtx;
+
+    // nullptr if id was never tracked or is out of range
+    Slot* slot(uint64_t id) const;
+
+public:
+    SubscriptionMonitor();
+    ~SubscriptionMonitor();
+    SubscriptionMonitor(const SubscriptionMonitor&) = delete;
+    SubscriptionMonitor& operator=(const SubscriptionMonitor&) = delete;
+
+    // Called on join, before the SUBSCRIBE is sent; ids are never reused
+    void track(int id, const std::string& destination, InboundDispatcher::Channel* route = nullptr);
+    void untrack(int id);
+    // The channel of an active subscription, or nullptr. The string stays valid for the
+    // monitor's lifetime, as slots are never reused.
+    const std::string* destination(uint64_t id) const;
+    // The dispatcher channel given to track(), or nullptr
+    InboundDispatcher::Channel* route(uint64_t id) const;
+
+    // A raw MESSAGE as it comes off the socket, before any drop or shedding
+    void onReceived(const std::string& frameStr);
+    // A raw MESSAGE as a worker starts handling it
+    void onHandled(const std::string& frameStr);
+
+    void printStats(std::ostream& out) const;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+
+// Hashed timing wheel driven by a single timer thread.
+// Timers are bucketed by deadline tick, so scheduling and cancelling are O(1)
+// no matter how many timers are pending. Callbacks run on the timer thread and
+// should be short; a slow callback delays every timer due after it.
+class TimerWheel {
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef uint64_t TimerId;
+
+private:
+    struct Timer {
+        TimerId id;
+        uint64_t tick;
+        std::function<void()> callback;
+    };
+
+    // Slot number recorded in index for timers that are due and about to run
+    static const size_t FIRING_SLOT = static_cast<size_t>(-1);
+
+    const Clock::duration tickLength;
+    const size_t slotMask;
+    std::vector<std::list<Timer>> slots;
+    std::list<Timer> firing;
+    // Where each pending timer lives, for O(1) cancel
+    std::unordered_map<TimerId, std::pair<size_t, std::list<Timer>::iterator>> index;
+
+    Clock::time_point origin;
+    uint64_t currentTick;
+    TimerId nextId;
+    TimerId runningId;
+    bool stopping;
+
+    std::mutex mtx;
+    std::condition_variable wakeup;
+    std::condition_variable callbackDone;
+    std::thread worker;
+
+    uint64_t tickOf(Clock::time_point when) const;
+    void run();
+
+public:
+    // tick: wheel resolution; slots is rounded up to a power of two
+    explicit TimerWheel(std::chrono::microseconds tick = std::chrono::microseconds(1000), size_t slots = 1024);
+    ~TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    TimerId schedule(Clock::time_point deadline, std::function<void()> callback);
+    TimerId scheduleAfter(Clock::duration delay, std::function<void()> callback);
+
+    // Remove a pending timer. If its callback is running on another thread, wait for it to finish.
+    // Returns false if the timer already fired or was never scheduled.
+    bool cancel(TimerId id);
+
+    size_t pending();
+
+    // Process-wide wheel with coarse 10ms ticks, for per-connection timers such as
+    // heart-beats: however many sessions there are, they share its one thread
+    static TimerWheel& shared();
+};
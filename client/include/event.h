@@ -48,3 +48,20 @@ struct names_and_events {
 
 // function that parses the json file and returns a names_and_events object
 names_and_events parseEventsFile(std::string json_path);
+
+// JSON Lines form of an events file: a header line {"team a": ..., "team b": ...} followed by one event object per line.
+// Both functions throw on malformed input.
+void parseEventsHeaderLine(const std::string &line, std::string &team_a_name, std::string &team_b_name);
+Event parseEventLine(const std::string &line, const std::string &team_a_name, const std::string &team_b_name);
+
+// Reads only the "user", "team a" and "team b" lines of an event body starting at text[begin],
+// without building an Event. Fields not found are left empty.
+void peekEventRouting(const std::string &text, size_t begin, std::string &user, std::string &team_a_name, std::string &team_b_name);
+
+// Multi-event bodies (report --batch): event bodies, each with its own "user" line, joined
+// by EVENT_SEPARATOR (ASCII record separator) in a SEND carrying an event-count header.
+// The server forwards bodies unchanged, so only clients know the format.
+const char EVENT_SEPARATOR = '\x1e';
+// The [first, second) range of each event in the body starting at text[begin], in order;
+// a plain body gives one
+std::vector<std::pair<size_t, size_t>> splitEventBatch(const std::string &text, size_t begin);
@@ -0,0 +1,197 @@
+#include "../include/AckBatcher.h"
+#include "../include/Frame.h"
+
+// What Frame("ACK") with an id header serializes to, without building one per message
+static void appendAck(std::string& wire, const std::string& ackId) {
+    wire += "ACK\nid:";
+    wire += ackId;
+    wire += "\n\n";
+    wire += '\0';
+}
+
+AckBatcher::AckBatcher(std::function<void()> flushWaiting, TimerWheel& timerWheel) :
+    wheel(timerWheel), flush(flushWaiting), mtx(), subscriptions(), acking(0), batchSize(32),
+    interval(std::chrono::milliseconds(100)), waiting(0), dirty(), timer(0),
+    ackFrames(0), messagesAcked(0), flushes(0), piggybacked(0)
+{
+}
+
+AckBatcher::~AckBatcher() {
+    reset();
+}
+
+bool AckBatcher::parseMode(const std::string& name, AckMode& mode) {
+    if (name == "auto") {
+        mode = AckMode::AUTO;
+    } else if (name == "client") {
+        mode = AckMode::CLIENT;
+    } else if (name == "client-individual") {
+        mode = AckMode::CLIENT_INDIVIDUAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* AckBatcher::modeName(AckMode mode) {
+    switch (mode) {
+        case AckMode::CLIENT: return "client";
+        case AckMode::CLIENT_INDIVIDUAL: return "client-individual";
+        default: return "auto";
+    }
+}
+
+void AckBatcher::setBatchSize(size_t messages) {
+    std::lock_guard<std::mutex> lock(mtx);
+    batchSize = messages == 0 ? 1 : messages;
+}
+
+void AckBatcher::setInterval(std::chrono::milliseconds flushInterval) {
+    std::lock_guard<std::mutex> lock(mtx);
+    interval = flushInterval;
+}
+
+void AckBatcher::track(uint64_t id, AckMode mode) {
+    if (mode == AckMode::AUTO) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    if (subscriptions.insert(std::make_pair(id, Subscription{mode, std::string(), std::vector<std::string>(), 0})).second) {
+        acking++;
+    }
+}
+
+void AckBatcher::untrack(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = subscriptions.find(id);
+    if (it == subscriptions.end()) {
+        return;
+    }
+    waiting -= it->second.waiting;
+    subscriptions.erase(it);
+    acking--;
+}
+
+void AckBatcher::reset() {
+    TimerWheel::TimerId armed;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        subscriptions.clear();
+        acking = 0;
+        waiting = 0;
+        dirty.clear();
+        armed = timer;
+        timer = 0;
+    }
+    // Outside mtx: cancel() waits for a running callback, which takes mtx
+    if (armed != 0) {
+        wheel.cancel(armed);
+    }
+}
+
+bool AckBatcher::onHandled(const std::string& frameStr) {
+    return add(frameStr, true);
+}
+
+bool AckBatcher::onDropped(const std::string& frameStr) {
+    return add(frameStr, false);
+}
+
+bool AckBatcher::add(const std::string& frameStr, bool handled) {
+    if (acking.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    uint64_t id;
+    if (!Frame::peekNumber(frameStr, "subscription", id)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = subscriptions.find(id);
+    if (it == subscriptions.end() || (!handled && it->second.mode == AckMode::CLIENT)) {
+        return false;
+    }
+    // STOMP 1.2 names the message to ack in an ack header; older brokers use message-id
+    std::string ackId = Frame::peekHeader(frameStr, "ack");
+    if (ackId.empty()) {
+        ackId = Frame::peekHeader(frameStr, "message-id");
+    }
+    Subscription& subscription = it->second;
+    if (subscription.mode == AckMode::CLIENT) {
+        subscription.latest = ackId;
+    } else {
+        subscription.ids.push_back(ackId);
+    }
+    if (subscription.waiting++ == 0) {
+        dirty.push_back(id);
+    }
+    waiting++;
+    if (waiting >= batchSize) {
+        return true;
+    }
+    if (timer == 0) {
+        timer = wheel.scheduleAfter(interval, [this]() { onTimer(); });
+    }
+    return false;
+}
+
+void AckBatcher::onTimer() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        timer = 0;
+        if (waiting == 0) {
+            return;   // a frame sent meanwhile took them along
+        }
+    }
+    flush();
+}
+
+size_t AckBatcher::drain(std::string& wire, bool piggyback) {
+    if (acking.load(std::memory_order_relaxed) == 0) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    if (waiting == 0) {
+        return 0;
+    }
+    size_t frames = 0;
+    for (uint64_t id : dirty) {
+        auto it = subscriptions.find(id);
+        if (it == subscriptions.end()) {
+            continue;   // untracked since
+        }
+        Subscription& subscription = it->second;
+        if (!subscription.latest.empty()) {
+            appendAck(wire, subscription.latest);
+            subscription.latest.clear();
+            frames++;
+        }
+        for (const std::string& ackId : subscription.ids) {
+            appendAck(wire, ackId);
+            frames++;
+        }
+        subscription.ids.clear();
+        subscription.waiting = 0;
+    }
+    dirty.clear();
+    messagesAcked += waiting;
+    waiting = 0;
+    ackFrames += frames;
+    if (piggyback) {
+        piggybacked += frames;
+    } else {
+        flushes++;
+    }
+    return frames;
+}
+
+void AckBatcher::printStats(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (subscriptions.empty() && ackFrames == 0) {
+        out << "Acks: auto" << std::endl;
+        return;
+    }
+    out << "Acks: " << subscriptions.size() << " subscriptions acking, batch " << batchSize << " or "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(interval).count() << "ms, "
+        << ackFrames << " ACK frames for " << messagesAcked << " messages, " << flushes << " writes of their own, "
+        << piggybacked << " piggybacked, " << waiting << " waiting" << std::endl;
+}
@@ -1,4 +1,10 @@
 #include "../include/ConnectionHandler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
 
 using boost::asio::ip::tcp;
 
@@ -9,7 +15,9 @@ using std::endl;
 using std::string;
 
 ConnectionHandler::ConnectionHandler(string host, short port) : host_(host), port_(port), io_service_(),
-                                                                socket_(io_service_) {}
+                                                                socket_(io_service_), inbox_(), inboxPos_(0),
+                                                                receiveTimestamps_(false), inboxReceivedAt_(),
+                                                                lastReadAt_(0), lastWriteAt_(0), badFrame_(false) {}
 
 ConnectionHandler::~ConnectionHandler() {
 	close();
@@ -24,6 +32,9 @@ bool ConnectionHandler::connect() {
 		socket_.connect(endpoint, error);
 		if (error)
 			throw boost::system::system_error(error);
+		// Frames are sent whole, so there is nothing for Nagle's algorithm to coalesce;
+		// it would only hold a frame back until the previous one is acknowledged
+		socket_.set_option(tcp::no_delay(true), error);
 	}
 	catch (std::exception &e) {
 		std::cerr << "Connection failed (Error: " << e.what() << ')' << std::endl;
@@ -32,12 +43,65 @@ bool ConnectionHandler::connect() {
 	return true;
 }
 
+bool ConnectionHandler::fillInbox() {
+	static const size_t CHUNK = 64 * 1024;
+	inbox_.erase(inbox_.begin(), inbox_.begin() + inboxPos_);
+	inboxPos_ = 0;
+	size_t used = inbox_.size();
+	inbox_.resize(used + CHUNK);
+	if (receiveTimestamps_) {
+		// recvmsg() directly, for the timestamp in the control data
+		char control[CMSG_SPACE(sizeof(scm_timestamping))];
+		iovec iov = {inbox_.data() + used, CHUNK};
+		msghdr msg = msghdr();
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		ssize_t received;
+		do {
+			received = ::recvmsg(socket_.native_handle(), &msg, 0);
+		} while (received < 0 && errno == EINTR);
+		if (received <= 0) {
+			inbox_.resize(used);
+			std::cerr << "recv failed (Error: " << (received == 0 ? "End of file" : std::strerror(errno)) << ')' << std::endl;
+			return false;
+		}
+		inbox_.resize(used + received);
+		lastReadAt_ = std::chrono::steady_clock::now().time_since_epoch().count();
+		inboxReceivedAt_ = std::chrono::system_clock::time_point();
+		for (cmsghdr *c = CMSG_FIRSTHDR(&msg); c != nullptr; c = CMSG_NXTHDR(&msg, c)) {
+			if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPING) {
+				scm_timestamping ts;
+				std::memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+				inboxReceivedAt_ = std::chrono::system_clock::time_point(
+					std::chrono::duration_cast<std::chrono::system_clock::duration>(
+						std::chrono::seconds(ts.ts[0].tv_sec) + std::chrono::nanoseconds(ts.ts[0].tv_nsec)));
+			}
+		}
+		return true;
+	}
+	boost::system::error_code error;
+	size_t received = socket_.read_some(boost::asio::buffer(inbox_.data() + used, CHUNK), error);
+	inbox_.resize(used + received);
+	if (error) {
+		std::cerr << "recv failed (Error: " << error.message() << ')' << std::endl;
+		return false;
+	}
+	lastReadAt_ = std::chrono::steady_clock::now().time_since_epoch().count();
+	return true;
+}
+
 bool ConnectionHandler::getBytes(char bytes[], unsigned int bytesToRead) {
-	size_t tmp = 0;
+	// Buffered bytes first
+	size_t tmp = std::min<size_t>(bytesToRead, inbox_.size() - inboxPos_);
+	std::copy(inbox_.begin() + inboxPos_, inbox_.begin() + inboxPos_ + tmp, bytes);
+	inboxPos_ += tmp;
 	boost::system::error_code error;
 	try {
 		while (!error && bytesToRead > tmp) {
 			tmp += socket_.read_some(boost::asio::buffer(bytes + tmp, bytesToRead - tmp), error);
+			lastReadAt_ = std::chrono::steady_clock::now().time_since_epoch().count();
 		}
 		if (error)
 			throw boost::system::system_error(error);
@@ -55,6 +119,7 @@ bool ConnectionHandler::sendBytes(const char bytes[], int bytesToWrite) {
 		while (!error && bytesToWrite > tmp) {
 			tmp += socket_.write_some(boost::asio::buffer(bytes + tmp, bytesToWrite - tmp), error);
 		}
+		lastWriteAt_ = std::chrono::steady_clock::now().time_since_epoch().count();
 		if (error)
 			throw boost::system::system_error(error);
 	} catch (std::exception &e) {
@@ -64,6 +129,13 @@ bool ConnectionHandler::sendBytes(const char bytes[], int bytesToWrite) {
 	return true;
 }
 
+bool ConnectionHandler::sendByteNow(char byte) {
+	if (::send(socket_.native_handle(), &byte, 1, MSG_DONTWAIT | MSG_NOSIGNAL) != 1)
+		return false;
+	lastWriteAt_ = std::chrono::steady_clock::now().time_since_epoch().count();
+	return true;
+}
+
 bool ConnectionHandler::getLine(std::string &line) {
 	return getFrameAscii(line, '\n');
 }
@@ -74,28 +146,150 @@ bool ConnectionHandler::sendLine(std::string &line) {
 
 
 bool ConnectionHandler::getFrameAscii(std::string &frame, char delimiter) {
-	char ch;
-	// Stop when we encounter the null character.
+	// Scan the buffered bytes for the delimiter and refill from the socket as needed,
+	// instead of one read per byte.
 	// Notice that the null character is not appended to the frame string.
-	try {
-		do {
-			if (!getBytes(&ch, 1)) {
-				return false;
-			}
-			if (ch != '\0')
-				frame.append(1, ch);
-		} while (delimiter != ch);
-	} catch (std::exception &e) {
-		std::cerr << "recv failed2 (Error: " << e.what() << ')' << std::endl;
+	bool atStart = frame.empty() && delimiter == '\0';
+	while (true) {
+		if (atStart) {
+			skipHeartBeats();
+			atStart = inboxPos_ == inbox_.size();
+		}
+		const char* begin = inbox_.data() + inboxPos_;
+		const char* end = inbox_.data() + inbox_.size();
+		const char* found = std::find(begin, end, delimiter);
+		const char* stop = (found == end) ? end : found + 1;
+		for (const char* p = begin; p != stop; ++p) {
+			if (*p != '\0')
+				frame.append(1, *p);
+		}
+		inboxPos_ += stop - begin;
+		if (found != end)
+			return true;
+		if (!fillInbox())
+			return false;
+	}
+}
+
+bool ConnectionHandler::enableReceiveTimestamps() {
+	int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+	if (setsockopt(socket_.native_handle(), SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0) {
+		std::cerr << "Receive timestamps unavailable (Error: " << std::strerror(errno) << ')' << std::endl;
 		return false;
 	}
+	receiveTimestamps_ = true;
+	return true;
+}
+
+void ConnectionHandler::skipHeartBeats() {
+	while (inboxPos_ < inbox_.size() && (inbox_[inboxPos_] == '\n' || inbox_[inboxPos_] == '\r'))
+		++inboxPos_;
+}
+
+// The content-length header of the frame whose header lines are [begin, headerEnd)
+static bool contentLength(const char* begin, const char* headerEnd, size_t &length) {
+	static const char KEY[] = "content-length:";
+	static const size_t KEY_LENGTH = sizeof(KEY) - 1;
+	const char* line = std::find(begin, headerEnd, '\n');
+	while (line != headerEnd) {
+		++line;
+		const char* eol = std::find(line, headerEnd, '\n');
+		if (static_cast<size_t>(eol - line) > KEY_LENGTH && std::equal(KEY, KEY + KEY_LENGTH, line)) {
+			length = 0;
+			for (const char* p = line + KEY_LENGTH; p != eol; ++p) {
+				if (*p < '0' || *p > '9')
+					return false;
+				length = length * 10 + static_cast<size_t>(*p - '0');
+			}
+			return true;
+		}
+		line = eol;
+	}
+	return false;
+}
+
+void ConnectionHandler::takeFrames(std::vector<std::string> &frames, char delimiter,
+                                   std::vector<std::chrono::system_clock::time_point> *receivedAt) {
+	while (!badFrame_) {
+		if (delimiter == '\0')
+			skipHeartBeats();
+		const char* begin = inbox_.data() + inboxPos_;
+		const char* end = inbox_.data() + inbox_.size();
+		const char* found = std::find(begin, end, delimiter);
+		if (found == end)
+			return;
+		// A body with content-length may hold NULs (a compressed one does): the frame
+		// ends that many bytes after the blank line, and the body is taken as is
+		static const char BLANK_LINE[] = "\n\n";
+		const char* headerEnd = std::search(begin, found, BLANK_LINE, BLANK_LINE + 2);
+		size_t length;
+		if (delimiter == '\0' && headerEnd != found && contentLength(begin, headerEnd, length)) {
+			const char* bodyStart = headerEnd + 2;
+			if (static_cast<size_t>(end - bodyStart) <= length)
+				return;   // the body or its NULL hasn't all arrived
+			found = bodyStart + length;
+			if (*found != '\0') {
+				std::cerr << "Malformed frame: no NULL after its " << length << " byte body" << std::endl;
+				badFrame_ = true;
+				shutdown();
+				return;
+			}
+			frames.push_back(std::string(begin, found));
+		} else {
+			frames.push_back(std::string());
+			std::string &frame = frames.back();
+			frame.reserve(found - begin);
+			for (const char* p = begin; p != found; ++p) {
+				if (*p != '\0')
+					frame.append(1, *p);
+			}
+		}
+		inboxPos_ += found + 1 - begin;
+		if (receivedAt != nullptr)
+			receivedAt->push_back(inboxReceivedAt_);
+	}
+}
+
+bool ConnectionHandler::getFrames(std::vector<std::string> &frames, char delimiter,
+                                  std::vector<std::chrono::system_clock::time_point> *receivedAt) {
+	takeFrames(frames, delimiter, receivedAt);
+	while (frames.empty()) {
+		if (badFrame_ || !fillInbox())
+			return false;
+		takeFrames(frames, delimiter, receivedAt);
+	}
+
+	// Whatever else already arrived joins this batch, up to a bound under a flood
+	static const size_t MAX_BATCH = 4096;
+	boost::system::error_code error;
+	while (!badFrame_ && frames.size() < MAX_BATCH && socket_.available(error) > 0 && !error) {
+		if (!fillInbox())
+			return true;   // the frames taken so far are still valid; the next call fails
+		takeFrames(frames, delimiter, receivedAt);
+	}
 	return true;
 }
 
 bool ConnectionHandler::sendFrameAscii(const std::string &frame, char delimiter) {
-	bool result = sendBytes(frame.c_str(), frame.length());
-	if (!result) return false;
-	return sendBytes(&delimiter, 1);
+	// One write, so the delimiter doesn't go out as a segment of its own
+	std::string wire;
+	wire.reserve(frame.length() + 1);
+	wire.append(frame);
+	wire.push_back(delimiter);
+	return sendBytes(wire.data(), wire.length());
+}
+
+std::chrono::steady_clock::time_point ConnectionHandler::lastReadAt() const {
+	return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(lastReadAt_.load()));
+}
+
+std::chrono::steady_clock::time_point ConnectionHandler::lastWriteAt() const {
+	return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(lastWriteAt_.load()));
+}
+
+void ConnectionHandler::shutdown() {
+	boost::system::error_code error;
+	socket_.shutdown(tcp::socket::shutdown_both, error);
 }
 
 // Close down the connection properly.
@@ -0,0 +1,87 @@
+#include "../include/EchoLatency.h"
+#include <algorithm>
+
+EchoLatency::Channel::Channel() :
+    roundTrip(), network(), client(), nextSequence(0), echoes(0), expectedSequence(0), missing(0)
+{
+}
+
+EchoLatency::EchoLatency() : mtx(), channels()
+{
+}
+
+EchoLatency::Channel& EchoLatency::channel(const std::string& destination) {
+    std::unique_ptr<Channel>& entry = channels[destination];
+    if (!entry) {
+        entry.reset(new Channel());
+    }
+    return *entry;
+}
+
+void EchoLatency::stamp(Frame& frame) {
+    uint64_t sentAt = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count());
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        sequence = channel(frame.getHeader("destination")).nextSequence++;
+    }
+    frame.addHeader("send-ts", std::to_string(sentAt));
+    frame.addHeader("send-seq", std::to_string(sequence));
+}
+
+void EchoLatency::onEcho(const std::string& frameStr, std::chrono::system_clock::time_point kernelReceived) {
+    Clock::time_point now = Clock::now();
+    std::string sentHeader = Frame::peekHeader(frameStr, "send-ts");
+    if (sentHeader.empty()) {
+        return;
+    }
+    Clock::time_point sentAt;
+    uint64_t sequence;
+    try {
+        sentAt = Clock::time_point(std::chrono::microseconds(std::stoull(sentHeader)));
+        sequence = std::stoull(Frame::peekHeader(frameStr, "send-seq"));
+    } catch (const std::exception& e) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    Channel& c = channel(Frame::peekHeader(frameStr, "destination"));
+    c.echoes++;
+    if (sequence >= c.expectedSequence) {
+        c.missing += sequence - c.expectedSequence;
+        c.expectedSequence = sequence + 1;
+    } else if (c.missing > 0) {
+        c.missing--;   // a late echo of one counted missing
+    }
+
+    c.roundTrip.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - sentAt).count()));
+    if (kernelReceived != std::chrono::system_clock::time_point()) {
+        // The kernel time is wall-clock; place it on the monotonic clock through "now"
+        Clock::time_point receivedAt = now - std::chrono::duration_cast<Clock::duration>(
+            std::chrono::system_clock::now() - kernelReceived);
+        c.network.record(static_cast<uint64_t>(std::max<long long>(0,
+            std::chrono::duration_cast<std::chrono::microseconds>(receivedAt - sentAt).count())));
+        c.client.record(static_cast<uint64_t>(std::max<long long>(0,
+            std::chrono::duration_cast<std::chrono::microseconds>(now - receivedAt).count())));
+    }
+}
+
+void EchoLatency::print(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (channels.empty()) {
+        out << "No reports sent yet" << std::endl;
+        return;
+    }
+    for (const auto& kv : channels) {
+        const Channel& c = *kv.second;
+        out << "Channel " << kv.first << ": " << c.nextSequence << " sent, " << c.echoes << " echoed, "
+            << c.missing << " missing" << std::endl;
+        c.roundTrip.print(out, "  round trip", "us");
+        if (c.network.count() > 0) {
+            c.network.print(out, "  network (send to kernel receive)", "us");
+            c.client.print(out, "  client (kernel receive to handling)", "us");
+        }
+    }
+}
@@ -87,3 +87,51 @@ Frame Frame::parse(const std::string& msg) {
     
     return frame;
 }
+
+std::string Frame::peekCommand(const std::string& msg) {
+    return msg.substr(0, msg.find('\n'));
+}
+
+std::string Frame::peekHeader(const std::string& msg, const std::string& key) {
+    size_t pos = msg.find('\n');
+    while (pos != std::string::npos && pos + 1 < msg.size() && msg[pos + 1] != '\n') {
+        size_t start = pos + 1;
+        pos = msg.find('\n', start);
+        size_t end = (pos == std::string::npos) ? msg.size() : pos;
+        if (end - start > key.size() && msg[start + key.size()] == ':' && msg.compare(start, key.size(), key) == 0) {
+            return msg.substr(start + key.size() + 1, end - start - key.size() - 1);
+        }
+    }
+    return "";
+}
+
+size_t Frame::peekBodyOffset(const std::string& msg) {
+    size_t pos = msg.find("\n\n");
+    return pos == std::string::npos ? msg.size() : pos + 2;
+}
+
+bool Frame::peekNumber(const std::string& msg, const char* key, uint64_t& value) {
+    size_t keyLength = std::char_traits<char>::length(key);
+    size_t pos = msg.find('\n');
+    while (pos != std::string::npos && pos + 1 < msg.size() && msg[pos + 1] != '\n') {
+        size_t start = pos + 1;
+        pos = msg.find('\n', start);
+        size_t end = (pos == std::string::npos) ? msg.size() : pos;
+        if (end - start > keyLength && msg[start + keyLength] == ':' && msg.compare(start, keyLength, key) == 0) {
+            size_t digit = start + keyLength + 1;
+            if (digit == end) {
+                return false;
+            }
+            uint64_t parsed = 0;
+            for (; digit < end; digit++) {
+                if (msg[digit] < '0' || msg[digit] > '9') {
+                    return false;
+                }
+                parsed = parsed * 10 + static_cast<uint64_t>(msg[digit] - '0');
+            }
+            value = parsed;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,152 @@
+#include "../include/FrameCompression.h"
+#include "../include/Lz4.h"
+#include <ctime>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+const char* const FrameCompression::ENCODING = "lz4";
+
+static const size_t SIZE_PREFIX = 4;
+
+// CPU time of the calling thread, so time spent descheduled isn't charged to a frame
+static uint64_t threadCpuNs() {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static std::string decimal(double value, int precision) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(precision) << value;
+    return text.str();
+}
+
+static std::string ratio(uint64_t plain, uint64_t encoded) {
+    return encoded > 0 ? decimal(static_cast<double>(plain) / encoded, 2) : "-";
+}
+
+static bool startsWith(const std::string& str, size_t pos, const char* prefix) {
+    return str.compare(pos, std::strlen(prefix), prefix) == 0;
+}
+
+FrameCompression::FrameCompression() :
+    enabled(false), threshold(512), attempts(0), compressed(0), plainBytesOut(0), encodedBytesOut(0),
+    compressNs(0), decompressed(0), encodedBytesIn(0), plainBytesIn(0), decompressNs(0), failures(0)
+{
+}
+
+void FrameCompression::setEnabled(bool on) {
+    enabled = on;
+}
+
+bool FrameCompression::isEnabled() const {
+    return enabled;
+}
+
+void FrameCompression::setThreshold(size_t bytes) {
+    threshold = bytes;
+}
+
+bool FrameCompression::encode(Frame& frame) {
+    if (!enabled) {
+        return false;
+    }
+    std::string body = frame.getBody();
+    if (body.size() < threshold || body.size() > MAX_BODY_SIZE) {
+        return false;
+    }
+
+    uint64_t start = threadCpuNs();
+    std::string block;
+    Lz4::compress(body.data(), body.size(), block);
+    std::string encoded;
+    encoded.reserve(SIZE_PREFIX + block.size());
+    for (size_t i = 0; i < SIZE_PREFIX; i++) {
+        encoded.push_back(static_cast<char>((body.size() >> (8 * i)) & 0xff));
+    }
+    encoded.append(block);
+    compressNs += threadCpuNs() - start;
+    attempts++;
+
+    if (encoded.size() >= body.size()) {
+        return false;
+    }
+    frame.setBody(encoded);
+    frame.addHeader("content-encoding", ENCODING);
+    frame.addHeader("content-length", std::to_string(encoded.size()));
+    compressed++;
+    plainBytesOut += body.size();
+    encodedBytesOut += encoded.size();
+    return true;
+}
+
+FrameCompression::Result FrameCompression::decode(const std::string& frameStr, std::string& decoded) {
+    std::string encoding = Frame::peekHeader(frameStr, "content-encoding");
+    if (encoding.empty()) {
+        return Result::PLAIN;
+    }
+    size_t bodyStart = Frame::peekBodyOffset(frameStr);
+    size_t encodedSize = frameStr.size() - bodyStart;
+    if (encoding != ENCODING || encodedSize < SIZE_PREFIX) {
+        failures++;
+        return Result::FAILED;
+    }
+
+    uint64_t start = threadCpuNs();
+    size_t plainSize = 0;
+    for (size_t i = 0; i < SIZE_PREFIX; i++) {
+        plainSize |= static_cast<size_t>(static_cast<unsigned char>(frameStr[bodyStart + i])) << (8 * i);
+    }
+    if (plainSize > MAX_BODY_SIZE) {
+        failures++;
+        return Result::FAILED;
+    }
+
+    // The header lines, less the two that described the encoded body
+    decoded.clear();
+    decoded.reserve(bodyStart + plainSize);
+    size_t pos = 0;
+    while (pos + 1 < bodyStart) {
+        size_t next = frameStr.find('\n', pos) + 1;
+        if (!startsWith(frameStr, pos, "content-encoding:") && !startsWith(frameStr, pos, "content-length:")) {
+            decoded.append(frameStr, pos, next - pos);
+        }
+        pos = next;
+    }
+    decoded.push_back('\n');
+
+    size_t plainStart = decoded.size();
+    decoded.resize(plainStart + plainSize);
+    if (!Lz4::decompress(frameStr.data() + bodyStart + SIZE_PREFIX, encodedSize - SIZE_PREFIX,
+                         &decoded[plainStart], plainSize)) {
+        failures++;
+        return Result::FAILED;
+    }
+    decompressNs += threadCpuNs() - start;
+    decompressed++;
+    encodedBytesIn += encodedSize;
+    plainBytesIn += plainSize;
+    return Result::DECODED;
+}
+
+void FrameCompression::printStats(std::ostream& out) {
+    out << "Compression: ";
+    if (enabled) {
+        out << ENCODING << " from " << threshold << " bytes";
+    } else {
+        out << "off";
+    }
+    if (attempts > 0) {
+        out << ", sent " << compressed << " of " << attempts << " bodies compressed, " << plainBytesOut
+            << " -> " << encodedBytesOut << " bytes (ratio " << ratio(plainBytesOut, encodedBytesOut) << "), "
+            << decimal(compressNs / attempts / 1000.0, 1) << "us CPU per body";
+    }
+    if (decompressed > 0 || failures > 0) {
+        out << ", received " << decompressed << " compressed, " << encodedBytesIn << " -> " << plainBytesIn
+            << " bytes (ratio " << ratio(plainBytesIn, encodedBytesIn) << "), "
+            << decimal(decompressed > 0 ? decompressNs / decompressed / 1000.0 : 0.0, 1) << "us CPU per body, "
+            << failures << " failed";
+    }
+    out << std::endl;
+}
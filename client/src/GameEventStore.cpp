@@ -0,0 +1,736 @@
+#include "../include/GameEventStore.h"
+#include <algorithm>
+
+// ============================================
+// StringPool
+// ============================================
+
+StringPool::StringPool() : ids(), strings() {}
+
+StringPool::StringPool(const StringPool& other) : ids(other.ids), strings(other.strings.size()) {
+    for (const auto& kv : ids) {
+        strings[kv.second] = &kv.first;
+    }
+}
+
+uint32_t StringPool::intern(const std::string& value) {
+    auto it = ids.find(value);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    auto inserted = ids.emplace(value, id).first;
+    strings.push_back(&inserted->first);
+    return id;
+}
+
+bool StringPool::find(const std::string& value, uint32_t& id) const {
+    auto it = ids.find(value);
+    if (it == ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+const std::string& StringPool::get(uint32_t id) const {
+    return *strings[id];
+}
+
+size_t StringPool::size() const {
+    return strings.size();
+}
+
+size_t StringPool::memoryBytes() const {
+    size_t bytes = strings.capacity() * sizeof(const std::string*);
+    for (const auto& kv : ids) {
+        // Node, key object and heap buffer when the string is too long for SSO
+        bytes += sizeof(kv) + sizeof(void*) + (kv.first.size() > 15 ? kv.first.capacity() + 1 : 0);
+    }
+    return bytes + ids.bucket_count() * sizeof(void*);
+}
+
+// ============================================
+// StatAggregates
+// ============================================
+
+StatAggregates::StatAggregates() : latest(), sortedKeys() {}
+
+void StatAggregates::apply(const StatUpdate& update, int time, const StringPool& pool) {
+    int scope = static_cast<int>(update.scope);
+    auto it = latest[scope].find(update.key);
+
+    if (it == latest[scope].end()) {
+        latest[scope][update.key] = Latest{time, update.value};
+        std::vector<uint32_t>& keys = sortedKeys[scope];
+        const std::string& text = pool.get(update.key);
+        auto pos = std::lower_bound(keys.begin(), keys.end(), text,
+            [&pool](uint32_t key, const std::string& value) { return pool.get(key) < value; });
+        keys.insert(pos, update.key);
+    } else if (time >= it->second.time) {
+        it->second = Latest{time, update.value};
+    }
+}
+
+void StatAggregates::merge(const StatAggregates& other, const StringPool& pool) {
+    for (int s = 0; s < 3; s++) {
+        for (uint32_t key : other.sortedKeys[s]) {
+            const Latest& value = other.latest[s].at(key);
+            apply(StatUpdate{key, value.value, static_cast<StatScope>(s)}, value.time, pool);
+        }
+    }
+}
+
+void StatAggregates::appendStats(StatScope scope, const StringPool& pool, std::string& out) const {
+    int s = static_cast<int>(scope);
+    for (uint32_t key : sortedKeys[s]) {
+        out += pool.get(key);
+        out += ": ";
+        out += pool.get(latest[s].at(key).value);
+        out += "\n";
+    }
+}
+
+size_t StatAggregates::statCount() const {
+    return sortedKeys[0].size() + sortedKeys[1].size() + sortedKeys[2].size();
+}
+
+size_t StatAggregates::memoryBytes() const {
+    size_t bytes = sizeof(StatAggregates);
+    for (int s = 0; s < 3; s++) {
+        // Node: next pointer, cached hash, key and value
+        bytes += latest[s].size() * (2 * sizeof(void*) + sizeof(uint32_t) + sizeof(Latest));
+        bytes += latest[s].bucket_count() * sizeof(void*);
+        bytes += sortedKeys[s].capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+// ============================================
+// EventStream
+// ============================================
+
+EventStream::EventStream() :
+    times(), nameIds(), descriptionOffsets(1, 0), descriptions(), updateOffsets(1, 0), updates(),
+    byTime(), byName(), byStat(), aggregates(), checkpointInterval(0), checkpoints()
+{
+}
+
+size_t EventStream::insertByTime(std::vector<uint32_t>& index, uint32_t i) {
+    // Reports mostly arrive in time order, making this a push_back
+    if (index.empty() || times[index.back()] <= times[i]) {
+        index.push_back(i);
+        return index.size() - 1;
+    }
+    auto pos = std::upper_bound(index.begin(), index.end(), times[i],
+        [this](int t, uint32_t e) { return t < times[e]; });
+    size_t position = pos - index.begin();
+    index.insert(pos, i);
+    return position;
+}
+
+void EventStream::applyEvent(StatAggregates& target, uint32_t i, const StringPool& pool) const {
+    for (const StatUpdate* u = updatesBegin(i); u != updatesEnd(i); ++u) {
+        target.apply(*u, times[i], pool);
+    }
+}
+
+void EventStream::rebuildCheckpoints(size_t position, const StringPool& pool) {
+    if (checkpointInterval == 0) {
+        checkpoints.clear();
+        return;
+    }
+    checkpoints.resize(std::min(checkpoints.size(), position / checkpointInterval));
+
+    StatAggregates replay = checkpoints.empty() ? StatAggregates() : checkpoints.back();
+    for (size_t p = checkpoints.size() * checkpointInterval; p < byTime.size(); p++) {
+        applyEvent(replay, byTime[p], pool);
+        if ((p + 1) % checkpointInterval == 0) {
+            checkpoints.push_back(replay);
+        }
+    }
+}
+
+void EventStream::append(const Event& event, StringPool& pool) {
+    uint32_t index = static_cast<uint32_t>(times.size());
+    int time = event.get_time();
+    times.push_back(time);
+    nameIds.push_back(pool.intern(event.get_name()));
+
+    descriptions += event.get_discription();
+    descriptionOffsets.push_back(descriptions.size());
+
+    for (const auto& kv : event.get_game_updates()) {
+        updates.push_back(StatUpdate{pool.intern(kv.first), pool.intern(kv.second), StatScope::GENERAL});
+    }
+    for (const auto& kv : event.get_team_a_updates()) {
+        updates.push_back(StatUpdate{pool.intern(kv.first), pool.intern(kv.second), StatScope::TEAM_A});
+    }
+    for (const auto& kv : event.get_team_b_updates()) {
+        updates.push_back(StatUpdate{pool.intern(kv.first), pool.intern(kv.second), StatScope::TEAM_B});
+    }
+    updateOffsets.push_back(static_cast<uint32_t>(updates.size()));
+
+    applyEvent(aggregates, index, pool);
+
+    insertByTime(byName[nameIds.back()], index);
+    for (const StatUpdate* u = updatesBegin(index); u != updatesEnd(index); ++u) {
+        // A key updated for both teams is indexed once
+        bool seen = false;
+        for (const StatUpdate* v = updatesBegin(index); v != u; ++v) {
+            seen = seen || v->key == u->key;
+        }
+        if (!seen) {
+            insertByTime(byStat[u->key], index);
+        }
+    }
+
+    // A late event lands before later ones, which invalidates the checkpoints past it
+    size_t position = insertByTime(byTime, index);
+    if (position + 1 < byTime.size()) {
+        rebuildCheckpoints(position, pool);
+    } else if (checkpointInterval != 0 && byTime.size() % checkpointInterval == 0) {
+        checkpoints.push_back(aggregates);
+    }
+}
+
+size_t EventStream::size() const {
+    return times.size();
+}
+
+int EventStream::time(size_t i) const {
+    return times[i];
+}
+
+uint32_t EventStream::nameId(size_t i) const {
+    return nameIds[i];
+}
+
+void EventStream::appendDescription(size_t i, std::string& out) const {
+    out.append(descriptions, descriptionOffsets[i], descriptionOffsets[i + 1] - descriptionOffsets[i]);
+}
+
+const char* EventStream::descriptionData(size_t i) const {
+    return descriptions.data() + descriptionOffsets[i];
+}
+
+size_t EventStream::descriptionLength(size_t i) const {
+    return descriptionOffsets[i + 1] - descriptionOffsets[i];
+}
+
+const StatUpdate* EventStream::updatesBegin(size_t i) const {
+    return updates.data() + updateOffsets[i];
+}
+
+const StatUpdate* EventStream::updatesEnd(size_t i) const {
+    return updates.data() + updateOffsets[i + 1];
+}
+
+const std::vector<uint32_t>& EventStream::timeOrder() const {
+    return byTime;
+}
+
+const StatAggregates& EventStream::stats() const {
+    return aggregates;
+}
+
+const std::vector<uint32_t>* EventStream::eventsNamed(uint32_t nameId) const {
+    auto it = byName.find(nameId);
+    return it == byName.end() ? nullptr : &it->second;
+}
+
+const std::vector<uint32_t>* EventStream::eventsWithStat(uint32_t keyId) const {
+    auto it = byStat.find(keyId);
+    return it == byStat.end() ? nullptr : &it->second;
+}
+
+void EventStream::timeRange(const std::vector<uint32_t>& index, int from, int to,
+                            size_t& begin, size_t& end) const {
+    auto first = std::lower_bound(index.begin(), index.end(), from,
+        [this](uint32_t e, int t) { return times[e] < t; });
+    auto last = std::upper_bound(first, index.end(), to,
+        [this](int t, uint32_t e) { return t < times[e]; });
+    begin = first - index.begin();
+    end = last - index.begin();
+}
+
+size_t EventStream::countUntil(int t) const {
+    auto pos = std::upper_bound(byTime.begin(), byTime.end(), t,
+        [this](int value, uint32_t i) { return value < times[i]; });
+    return pos - byTime.begin();
+}
+
+StatAggregates EventStream::statsOf(size_t count, const StringPool& pool) const {
+    if (count >= byTime.size()) {
+        return aggregates;
+    }
+
+    size_t from = 0;
+    StatAggregates result;
+    if (checkpointInterval != 0 && count >= checkpointInterval) {
+        size_t j = std::min(count / checkpointInterval, checkpoints.size());
+        if (j > 0) {
+            result = checkpoints[j - 1];
+            from = j * checkpointInterval;
+        }
+    }
+    for (size_t p = from; p < count; p++) {
+        applyEvent(result, byTime[p], pool);
+    }
+    return result;
+}
+
+void EventStream::setCheckpointInterval(size_t interval, const StringPool& pool) {
+    if (interval == checkpointInterval) {
+        return;
+    }
+    checkpointInterval = interval;
+    std::vector<StatAggregates>().swap(checkpoints);
+    rebuildCheckpoints(0, pool);
+}
+
+size_t EventStream::memoryBytes() const {
+    size_t bytes = times.capacity() * sizeof(int32_t) + nameIds.capacity() * sizeof(uint32_t) +
+                   descriptionOffsets.capacity() * sizeof(uint64_t) + descriptions.capacity() +
+                   updateOffsets.capacity() * sizeof(uint32_t) + updates.capacity() * sizeof(StatUpdate) +
+                   byTime.capacity() * sizeof(uint32_t) + aggregates.memoryBytes();
+    for (const auto* index : {&byName, &byStat}) {
+        for (const auto& kv : *index) {
+            bytes += 2 * sizeof(void*) + sizeof(kv) + kv.second.capacity() * sizeof(uint32_t);
+        }
+        bytes += index->bucket_count() * sizeof(void*);
+    }
+    return bytes;
+}
+
+size_t EventStream::checkpointMemoryBytes() const {
+    size_t bytes = checkpoints.capacity() * sizeof(StatAggregates);
+    for (const StatAggregates& c : checkpoints) {
+        bytes += c.memoryBytes() - sizeof(StatAggregates);
+    }
+    return bytes;
+}
+
+// ============================================
+// GameEventStore
+// ============================================
+
+GameEventStore::Game::Game(const Game& other) :
+    team_a_name(other.team_a_name), team_b_name(other.team_b_name), streams(other.streams), text(other.text),
+    events()
+{
+    // Both stream maps hold the same users in the same order
+    std::map<const EventStream*, std::map<std::string, EventStream>::const_iterator> copies;
+    auto copy = streams.cbegin();
+    for (auto it = other.streams.cbegin(); it != other.streams.cend(); ++it, ++copy) {
+        copies[&it->second] = copy;
+    }
+    events.reserve(other.events.size());
+    for (const EventRef& ref : other.events) {
+        auto target = copies[ref.stream];
+        events.push_back(EventRef{&target->first, &target->second, ref.event});
+    }
+}
+
+GameEventStore::GameEventStore() : pool(), games(), checkpointInterval(256) {}
+
+void GameEventStore::add(const std::string& game, const std::string& user, const Event& event) {
+    Game& g = games[game];
+    if (g.streams.empty()) {
+        g.team_a_name = event.get_team_a_name();
+        g.team_b_name = event.get_team_b_name();
+    }
+    auto it = g.streams.find(user);
+    if (it == g.streams.end()) {
+        it = g.streams.emplace(user, EventStream()).first;
+        it->second.setCheckpointInterval(checkpointInterval, pool);
+    }
+    EventStream& stream = it->second;
+    stream.append(event, pool);
+
+    uint32_t id = static_cast<uint32_t>(g.events.size());
+    g.events.push_back(EventRef{&it->first, &stream, static_cast<uint32_t>(stream.size() - 1)});
+    g.text.add(id, event.get_discription());
+}
+
+bool GameEventStore::hasGame(const std::string& game) const {
+    return games.find(game) != games.end();
+}
+
+bool GameEventStore::hasStream(const std::string& game, const std::string& user) const {
+    auto git = games.find(game);
+    return git != games.end() && git->second.streams.find(user) != git->second.streams.end();
+}
+
+const EventStream* GameEventStore::findStream(const std::string& game, const std::string& user,
+                                              const Game*& g) const {
+    auto git = games.find(game);
+    if (git == games.end()) {
+        return nullptr;
+    }
+    auto sit = git->second.streams.find(user);
+    if (sit == git->second.streams.end()) {
+        return nullptr;
+    }
+    g = &git->second;
+    return &sit->second;
+}
+
+void GameEventStore::render(const Game& g, const EventStream& stream, const StatAggregates& stats,
+                            size_t count, std::string& out) const {
+    out += g.team_a_name + " vs " + g.team_b_name + "\n";
+    out += "Game stats:\n";
+    out += "General stats:\n";
+    stats.appendStats(StatScope::GENERAL, pool, out);
+    out += g.team_a_name + " stats:\n";
+    stats.appendStats(StatScope::TEAM_A, pool, out);
+    out += g.team_b_name + " stats:\n";
+    stats.appendStats(StatScope::TEAM_B, pool, out);
+
+    out += "Game event reports:\n";
+    const std::vector<uint32_t>& order = stream.timeOrder();
+    for (size_t p = 0; p < count; p++) {
+        uint32_t i = order[p];
+        out += std::to_string(stream.time(i));
+        out += " - ";
+        out += pool.get(stream.nameId(i));
+        out += ":\n\n";
+        stream.appendDescription(i, out);
+        out += "\n\n\n";
+    }
+}
+
+bool GameEventStore::summarize(const std::string& game, const std::string& user, std::string& out) const {
+    const Game* g = nullptr;
+    const EventStream* stream = findStream(game, user, g);
+    if (stream == nullptr) {
+        return false;
+    }
+
+    out.clear();
+    if (stream->size() == 0) {
+        return true;
+    }
+    render(*g, *stream, stream->stats(), stream->size(), out);
+    return true;
+}
+
+bool GameEventStore::summarizeAt(const std::string& game, const std::string& user, int time,
+                                 std::string& out) const {
+    const Game* g = nullptr;
+    const EventStream* stream = findStream(game, user, g);
+    if (stream == nullptr) {
+        return false;
+    }
+
+    out.clear();
+    size_t count = stream->countUntil(time);
+    render(*g, *stream, stream->statsOf(count, pool), count, out);
+    return true;
+}
+
+bool GameEventStore::summarizeMerged(const std::string& game, int time, std::ostream& out,
+                                     size_t& duplicates) const {
+    auto git = games.find(game);
+    if (git == games.end()) {
+        return false;
+    }
+    const Game& g = git->second;
+
+    // Per user: the time-ordered prefix up to `time`, and its stats folded together.
+    // Users are folded in name order, matching how the merge below breaks time ties.
+    std::vector<const EventStream*> streams;
+    std::vector<size_t> counts;
+    StatAggregates stats;
+    for (const auto& s : g.streams) {
+        size_t count = s.second.countUntil(time);
+        if (count == 0) {
+            continue;
+        }
+        streams.push_back(&s.second);
+        counts.push_back(count);
+        stats.merge(s.second.statsOf(count, pool), pool);
+    }
+
+    std::string header;
+    header += g.team_a_name + " vs " + g.team_b_name + "\n";
+    header += "Game stats:\n";
+    header += "General stats:\n";
+    stats.appendStats(StatScope::GENERAL, pool, header);
+    header += g.team_a_name + " stats:\n";
+    stats.appendStats(StatScope::TEAM_A, pool, header);
+    header += g.team_b_name + " stats:\n";
+    stats.appendStats(StatScope::TEAM_B, pool, header);
+    header += "Game event reports:\n";
+    out << header;
+
+    // Min-heap of (time, stream, position) heads, one per stream
+    struct Head {
+        int time;
+        uint32_t stream;
+        size_t position;
+    };
+    auto later = [](const Head& a, const Head& b) {
+        return a.time != b.time ? a.time > b.time : a.stream > b.stream;
+    };
+    std::vector<Head> heap;
+    for (uint32_t s = 0; s < streams.size(); s++) {
+        heap.push_back(Head{streams[s]->time(streams[s]->timeOrder()[0]), s, 0});
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    // Events already written at the current time, by hash of (time, name, description)
+    struct Written {
+        uint64_t hash;
+        const EventStream* stream;
+        uint32_t event;
+    };
+    std::vector<Written> sameTime;
+    int currentTime = 0;
+    duplicates = 0;
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Head head = heap.back();
+        heap.pop_back();
+        const EventStream& stream = *streams[head.stream];
+        uint32_t i = stream.timeOrder()[head.position];
+        if (head.position + 1 < counts[head.stream]) {
+            heap.push_back(Head{stream.time(stream.timeOrder()[head.position + 1]), head.stream, head.position + 1});
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+
+        if (sameTime.empty() || head.time != currentTime) {
+            sameTime.clear();
+            currentTime = head.time;
+        }
+
+        // FNV-1a; the name is an interned id, so it hashes as a number
+        uint64_t hash = 14695981039346656037ULL;
+        auto mix = [&hash](const char* data, size_t length) {
+            for (size_t b = 0; b < length; b++) {
+                hash = (hash ^ static_cast<unsigned char>(data[b])) * 1099511628211ULL;
+            }
+        };
+        uint32_t nameId = stream.nameId(i);
+        mix(reinterpret_cast<const char*>(&head.time), sizeof(head.time));
+        mix(reinterpret_cast<const char*>(&nameId), sizeof(nameId));
+        mix(stream.descriptionData(i), stream.descriptionLength(i));
+
+        bool duplicate = false;
+        for (const Written& w : sameTime) {
+            if (w.hash == hash && w.stream->nameId(w.event) == nameId &&
+                w.stream->descriptionLength(w.event) == stream.descriptionLength(i) &&
+                std::equal(stream.descriptionData(i), stream.descriptionData(i) + stream.descriptionLength(i),
+                           w.stream->descriptionData(w.event))) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) {
+            duplicates++;
+            continue;
+        }
+        sameTime.push_back(Written{hash, &stream, i});
+
+        out << head.time << " - " << pool.get(nameId) << ":\n\n";
+        out.write(stream.descriptionData(i), stream.descriptionLength(i));
+        out << "\n\n\n";
+    }
+    return true;
+}
+
+bool GameEventStore::query(const EventQuery& q, std::string& out, size_t& matches) const {
+    auto git = games.find(q.game);
+    if (git == games.end()) {
+        return false;
+    }
+    const Game& g = git->second;
+    if (!q.user.empty() && g.streams.find(q.user) == g.streams.end()) {
+        return false;
+    }
+
+    out.clear();
+    matches = 0;
+    uint32_t nameId = 0;
+    uint32_t keyId = 0;
+    if ((!q.eventName.empty() && !pool.find(q.eventName, nameId)) ||
+        (!q.statKey.empty() && !pool.find(q.statKey, keyId))) {
+        return true;
+    }
+
+    // (time, stream, event) of every match; only matches are sorted across users
+    struct Match {
+        int time;
+        const std::string* user;
+        const EventStream* stream;
+        uint32_t event;
+    };
+    std::vector<Match> found;
+
+    for (const auto& s : g.streams) {
+        if (!q.user.empty() && s.first != q.user) {
+            continue;
+        }
+        const EventStream& stream = s.second;
+
+        // Walk the narrowest index and check the other filter per event
+        const std::vector<uint32_t>* index = &stream.timeOrder();
+        const std::vector<uint32_t>* named = q.eventName.empty() ? index : stream.eventsNamed(nameId);
+        const std::vector<uint32_t>* withStat = q.statKey.empty() ? index : stream.eventsWithStat(keyId);
+        if (named == nullptr || withStat == nullptr) {
+            continue;
+        }
+        bool checkName = false;
+        bool checkStat = false;
+        if (named->size() <= withStat->size()) {
+            index = named;
+            checkStat = !q.statKey.empty();
+        } else {
+            index = withStat;
+            checkName = !q.eventName.empty();
+        }
+
+        size_t begin = 0;
+        size_t end = 0;
+        stream.timeRange(*index, q.from, q.to, begin, end);
+        for (size_t p = begin; p < end; p++) {
+            uint32_t i = (*index)[p];
+            if (checkName && stream.nameId(i) != nameId) {
+                continue;
+            }
+            if (checkStat) {
+                bool updated = false;
+                for (const StatUpdate* u = stream.updatesBegin(i); u != stream.updatesEnd(i) && !updated; ++u) {
+                    updated = u->key == keyId;
+                }
+                if (!updated) {
+                    continue;
+                }
+            }
+            found.push_back(Match{stream.time(i), &s.first, &stream, i});
+        }
+    }
+
+    std::stable_sort(found.begin(), found.end(),
+        [](const Match& a, const Match& b) { return a.time < b.time; });
+
+    const std::string* scopeNames[3] = {nullptr, &g.team_a_name, &g.team_b_name};
+    for (const Match& m : found) {
+        out += std::to_string(m.time);
+        out += " - ";
+        out += pool.get(m.stream->nameId(m.event));
+        out += " (" + *m.user + "):\n";
+        if (!q.statKey.empty()) {
+            for (const StatUpdate* u = m.stream->updatesBegin(m.event); u != m.stream->updatesEnd(m.event); ++u) {
+                if (u->key == keyId) {
+                    const std::string* scope = scopeNames[static_cast<int>(u->scope)];
+                    out += scope == nullptr ? "general" : *scope;
+                    out += " " + pool.get(u->key) + ": " + pool.get(u->value) + "\n";
+                }
+            }
+        }
+        out += "\n";
+        m.stream->appendDescription(m.event, out);
+        out += "\n\n\n";
+    }
+    matches = found.size();
+    return true;
+}
+
+bool GameEventStore::search(const std::string& game, const std::vector<std::string>& words, bool any,
+                            std::string& out, size_t& matches) const {
+    if (game != "*" && games.find(game) == games.end()) {
+        return false;
+    }
+
+    out.clear();
+    matches = 0;
+    for (const auto& git : games) {
+        if (game != "*" && git.first != game) {
+            continue;
+        }
+        const Game& g = git.second;
+
+        std::vector<EventRef> found;
+        for (uint32_t id : g.text.search(words, any)) {
+            found.push_back(g.events[id]);
+        }
+        std::stable_sort(found.begin(), found.end(), [](const EventRef& a, const EventRef& b) {
+            return a.stream->time(a.event) < b.stream->time(b.event);
+        });
+
+        for (const EventRef& ref : found) {
+            out += git.first + " ";
+            out += std::to_string(ref.stream->time(ref.event));
+            out += " - ";
+            out += pool.get(ref.stream->nameId(ref.event));
+            out += " (" + *ref.user + ")\n";
+        }
+        matches += found.size();
+    }
+    return true;
+}
+
+void GameEventStore::setCheckpointInterval(size_t interval) {
+    checkpointInterval = interval;
+    for (auto& g : games) {
+        for (auto& s : g.second.streams) {
+            s.second.setCheckpointInterval(interval, pool);
+        }
+    }
+}
+
+size_t GameEventStore::eventCount() const {
+    size_t count = 0;
+    for (const auto& g : games) {
+        for (const auto& s : g.second.streams) {
+            count += s.second.size();
+        }
+    }
+    return count;
+}
+
+size_t GameEventStore::memoryBytes() const {
+    size_t bytes = pool.memoryBytes();
+    for (const auto& g : games) {
+        for (const auto& s : g.second.streams) {
+            bytes += s.second.memoryBytes();
+        }
+    }
+    return bytes;
+}
+
+size_t GameEventStore::checkpointMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& g : games) {
+        for (const auto& s : g.second.streams) {
+            bytes += s.second.checkpointMemoryBytes();
+        }
+    }
+    return bytes;
+}
+
+size_t GameEventStore::textIndexMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& g : games) {
+        bytes += g.second.text.memoryBytes() + g.second.events.capacity() * sizeof(EventRef);
+    }
+    return bytes;
+}
+
+size_t GameEventStore::searchTermCount() const {
+    size_t terms = 0;
+    for (const auto& g : games) {
+        terms += g.second.text.termCount();
+    }
+    return terms;
+}
+
+size_t GameEventStore::searchPostingCount() const {
+    size_t postings = 0;
+    for (const auto& g : games) {
+        postings += g.second.text.postingCount();
+    }
+    return postings;
+}
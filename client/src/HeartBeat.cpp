@@ -0,0 +1,137 @@
+#include "../include/HeartBeat.h"
+#include <algorithm>
+#include <sstream>
+
+HeartBeat::HeartBeat(TimerWheel& timerWheel) :
+    wheel(timerWheel), mtx(), running(false), sendTimer(0), checkTimer(0), sendEvery(), expectEvery(),
+    lastSent(), lastReceived(), sendBeat(), onTimeout(), beatsSent(0), timeouts(0)
+{
+}
+
+HeartBeat::~HeartBeat() {
+    stop();
+}
+
+bool HeartBeat::parse(const std::string& header, uint64_t& first, uint64_t& second) {
+    std::istringstream in(header);
+    char comma = 0;
+    if (!(in >> first >> comma >> second) || comma != ',') {
+        return false;
+    }
+    return true;
+}
+
+void HeartBeat::negotiate(uint64_t cx, uint64_t cy, uint64_t sx, uint64_t sy, uint64_t& sendMs, uint64_t& expectMs) {
+    sendMs = (cx == 0 || sy == 0) ? 0 : std::max(cx, sy);
+    expectMs = (sx == 0 || cy == 0) ? 0 : std::max(sx, cy);
+}
+
+void HeartBeat::start(uint64_t sendMs, uint64_t expectMs, ActivityProbe sentProbe, ActivityProbe receivedProbe,
+                      std::function<bool()> beat, std::function<void()> timeout) {
+    stop();
+    beatsSent = 0;
+    timeouts = 0;
+    std::lock_guard<std::mutex> lock(mtx);
+    running = true;
+    sendEvery = std::chrono::milliseconds(sendMs);
+    expectEvery = std::chrono::milliseconds(expectMs);
+    lastSent = sentProbe;
+    lastReceived = receivedProbe;
+    sendBeat = beat;
+    onTimeout = timeout;
+    Clock::time_point now = Clock::now();
+    if (sendMs > 0) {
+        armSend(now + sendEvery);
+    }
+    if (expectMs > 0) {
+        armCheck(now + 2 * expectEvery);
+    }
+}
+
+void HeartBeat::stop() {
+    TimerWheel::TimerId send;
+    TimerWheel::TimerId check;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        running = false;
+        send = sendTimer;
+        check = checkTimer;
+        sendTimer = 0;
+        checkTimer = 0;
+    }
+    // Outside mtx: cancel() waits for a running callback, which takes mtx
+    if (send != 0) {
+        wheel.cancel(send);
+    }
+    if (check != 0) {
+        wheel.cancel(check);
+    }
+}
+
+void HeartBeat::armSend(Clock::time_point at) {
+    sendTimer = wheel.schedule(at, [this]() { onSendTimer(); });
+}
+
+void HeartBeat::armCheck(Clock::time_point at) {
+    checkTimer = wheel.schedule(at, [this]() { onCheckTimer(); });
+}
+
+void HeartBeat::onSendTimer() {
+    std::function<bool()> beat;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!running) {
+            return;
+        }
+        Clock::time_point sent = lastSent();
+        if (Clock::now() - sent < sendEvery) {
+            armSend(sent + sendEvery);
+            return;
+        }
+        beat = sendBeat;
+    }
+    // Outside mtx, so stop() never waits behind the socket. A beat that can't be written
+    // at once is skipped until the next interval.
+    if (beat()) {
+        beatsSent++;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running) {
+        armSend(Clock::now() + sendEvery);
+    }
+}
+
+void HeartBeat::onCheckTimer() {
+    std::function<void()> timeout;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!running) {
+            return;
+        }
+        Clock::time_point received = lastReceived();
+        if (Clock::now() - received < 2 * expectEvery) {
+            armCheck(received + 2 * expectEvery);
+            return;
+        }
+        checkTimer = 0;
+        timeout = onTimeout;
+    }
+    timeouts++;
+    timeout();
+}
+
+void HeartBeat::printStats(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!running) {
+        out << "Heart-beat: off";
+        if (beatsSent > 0 || timeouts > 0) {
+            out << " (last session: " << beatsSent << " beats sent, " << timeouts << " timeouts)";
+        }
+        out << std::endl;
+        return;
+    }
+    out << "Heart-beat: send every "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(sendEvery).count() << "ms, expect every "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(expectEvery).count() << "ms, "
+        << beatsSent << " beats sent, " << timeouts << " timeouts" << std::endl;
+}
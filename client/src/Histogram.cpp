@@ -0,0 +1,137 @@
+#include "../include/Histogram.h"
+#include <iomanip>
+#include <sstream>
+#include <limits>
+
+Histogram::Histogram() : counts(), total(0), sum(0), minValue(std::numeric_limits<uint64_t>::max()), maxValue(0) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+static int highestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+int Histogram::bucketIndex(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+    // value >> shift lands in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    int shift = highestBit(value) - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>(value >> shift) - SUB_BUCKETS;
+}
+
+uint64_t Histogram::bucketLow(int index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKETS + SUB_BUCKETS);
+    return sub << shift;
+}
+
+uint64_t Histogram::bucketHigh(int index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    return bucketLow(index) + ((uint64_t(1) << shift) - 1);
+}
+
+void Histogram::record(uint64_t value) {
+    counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t seen = minValue.load(std::memory_order_relaxed);
+    while (value < seen && !minValue.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+    seen = maxValue.load(std::memory_order_relaxed);
+    while (value > seen && !maxValue.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+void Histogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    minValue.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    maxValue.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::count() const {
+    return total.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::min() const {
+    return count() == 0 ? 0 : minValue.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::max() const {
+    return maxValue.load(std::memory_order_relaxed);
+}
+
+double Histogram::mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / n;
+}
+
+uint64_t Histogram::percentile(double p) const {
+    uint64_t n = count();
+    if (n == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * n + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t high = bucketHigh(i);
+            return high < max() ? high : max();
+        }
+    }
+    return max();
+}
+
+void Histogram::print(std::ostream& out, const std::string& title, const std::string& unit) const {
+    uint64_t n = count();
+    out << title << ": count=" << n;
+    if (n == 0) {
+        out << std::endl;
+        return;
+    }
+    std::ostringstream meanText;
+    meanText << std::fixed << std::setprecision(1) << mean();
+    out << " min=" << min() << unit << " mean=" << meanText.str() << unit
+        << " max=" << max() << unit << std::endl;
+    out << "  p50=" << percentile(50) << unit << " p90=" << percentile(90) << unit
+        << " p99=" << percentile(99) << unit << " p99.9=" << percentile(99.9) << unit << std::endl;
+
+    // Collapse the sub-buckets into power-of-two ranges for display
+    uint64_t ranges[65] = {0};
+    uint64_t largest = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        uint64_t c = counts[i].load(std::memory_order_relaxed);
+        if (c == 0) continue;
+        uint64_t low = bucketLow(i);
+        int range = low == 0 ? 0 : highestBit(low) + 1;
+        ranges[range] += c;
+        if (ranges[range] > largest) largest = ranges[range];
+    }
+
+    for (int r = 0; r < 65; r++) {
+        if (ranges[r] == 0) continue;
+        uint64_t low = r == 0 ? 0 : uint64_t(1) << (r - 1);
+        uint64_t high = r == 0 ? 1 : (r == 64 ? std::numeric_limits<uint64_t>::max() : uint64_t(1) << r);
+        int bar = static_cast<int>(40 * ranges[r] / largest);
+        out << "  [" << std::setw(10) << low << ", " << std::setw(10) << high << ")" << unit << " "
+            << std::string(bar > 0 ? bar : 1, '#') << " " << ranges[r] << std::endl;
+    }
+}
@@ -0,0 +1,311 @@
+#include "../include/InboundDispatcher.h"
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+InboundDispatcher::Channel::Channel() :
+    hash(0), tokens(0), refilledAt(), received(0), dropped(0), overBudget(0)
+{
+}
+
+InboundDispatcher::Worker::Worker() :
+    mtx(), ready(), idle(), queue(), busy(false), stopping(false), maxDepth(0), processed(0),
+    reportedProcessed(0), thread()
+{
+}
+
+InboundDispatcher::InboundDispatcher(Handler handler, size_t workerCount, Handler dropHandler) :
+    handler(handler), dropHandler(dropHandler), poolMtx(), workers(), reportedAt(Clock::now()), channels(), rateLimit(0),
+    queueLimit(65536), policy(Policy::DROP_OLDEST), keepEvery(2)
+{
+    std::lock_guard<std::mutex> lock(poolMtx);
+    startWorkers(workerCount);
+}
+
+InboundDispatcher::~InboundDispatcher() {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    stopWorkers();
+}
+
+void InboundDispatcher::run(Worker& worker) {
+    std::unique_lock<std::mutex> lock(worker.mtx);
+    while (true) {
+        worker.ready.wait(lock, [&worker]() { return !worker.queue.empty() || worker.stopping; });
+        if (worker.queue.empty()) {
+            return;   // stopping, and everything queued has been handled
+        }
+
+        std::string frame = std::move(worker.queue.front().frame);
+        worker.queue.pop_front();
+        worker.busy = true;
+        lock.unlock();
+
+        handler(frame);
+        worker.processed++;
+
+        lock.lock();
+        worker.busy = false;
+        if (worker.queue.empty()) {
+            worker.idle.notify_all();
+        }
+    }
+}
+
+void InboundDispatcher::startWorkers(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        workers.push_back(std::unique_ptr<Worker>(new Worker()));
+        Worker* worker = workers.back().get();
+        worker->thread = std::thread([this, worker]() { run(*worker); });
+    }
+    reportedAt = Clock::now();
+}
+
+void InboundDispatcher::stopWorkers() {
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mtx);
+            worker->stopping = true;
+        }
+        worker->ready.notify_one();
+    }
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+    workers.clear();
+}
+
+void InboundDispatcher::setWorkers(size_t count) {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    stopWorkers();
+    startWorkers(count);
+}
+
+void InboundDispatcher::setRateLimit(double framesPerSecond) {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    rateLimit = framesPerSecond;
+    for (auto& kv : channels) {
+        kv.second.tokens = framesPerSecond;   // start each channel with a full bucket
+        kv.second.refilledAt = Clock::now();
+    }
+}
+
+void InboundDispatcher::setQueueLimit(size_t frames) {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    queueLimit = frames;
+}
+
+void InboundDispatcher::setPolicy(const std::string& name) {
+    static const std::string keepPrefix = "keep-every-";
+    Policy parsed;
+    size_t every = 0;
+    if (name == "drop-newest") {
+        parsed = Policy::DROP_NEWEST;
+    } else if (name == "drop-oldest") {
+        parsed = Policy::DROP_OLDEST;
+    } else if (name.compare(0, keepPrefix.size(), keepPrefix) == 0) {
+        parsed = Policy::KEEP_EVERY_NTH;
+        every = std::stoul(name.substr(keepPrefix.size()));
+        if (every == 0) {
+            throw std::invalid_argument("keep-every-0");
+        }
+    } else {
+        throw std::invalid_argument(name);
+    }
+
+    std::lock_guard<std::mutex> lock(poolMtx);
+    policy = parsed;
+    if (every > 0) {
+        keepEvery = every;
+    }
+}
+
+std::string InboundDispatcher::policyName() const {
+    switch (policy) {
+        case Policy::DROP_NEWEST:
+            return "drop-newest";
+        case Policy::DROP_OLDEST:
+            return "drop-oldest";
+        case Policy::KEEP_EVERY_NTH:
+            break;
+    }
+    return "keep-every-" + std::to_string(keepEvery);
+}
+
+bool InboundDispatcher::takeToken(Channel& channel, Clock::time_point now) {
+    if (rateLimit <= 0) {
+        return true;
+    }
+    double elapsed = std::chrono::duration<double>(now - channel.refilledAt).count();
+    channel.tokens = std::min(rateLimit, channel.tokens + elapsed * rateLimit);
+    channel.refilledAt = now;
+    if (channel.tokens < 1) {
+        return false;
+    }
+    channel.tokens -= 1;
+    return true;
+}
+
+bool InboundDispatcher::dropOldest(Worker& worker, Channel* channel, std::string& shed) {
+    for (auto it = worker.queue.begin(); it != worker.queue.end(); ++it) {
+        if (channel == nullptr || it->channel == channel) {
+            it->channel->dropped++;
+            shed = std::move(it->frame);
+            worker.queue.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+InboundDispatcher::Channel& InboundDispatcher::findChannel(const std::string& key, Clock::time_point now) {
+    // Looked up before inserting, so a known channel costs no key copy
+    auto it = channels.find(key);
+    if (it == channels.end()) {
+        it = channels.emplace(key, Channel()).first;
+        it->second.hash = std::hash<std::string>()(key);
+        it->second.tokens = rateLimit;
+        it->second.refilledAt = now;
+    }
+    return it->second;
+}
+
+InboundDispatcher::Channel* InboundDispatcher::channel(const std::string& key) {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    return &findChannel(key, Clock::now());
+}
+
+void InboundDispatcher::dispatch(const std::string& key, std::string&& frame) {
+    std::string shed;
+    bool dropped;
+    {
+        std::lock_guard<std::mutex> lock(poolMtx);
+        Clock::time_point now = Clock::now();
+        dropped = dispatchLocked(findChannel(key, now), std::move(frame), now, shed);
+    }
+    // Outside the locks: the handler may write to the connection
+    if (dropped && dropHandler) {
+        dropHandler(shed);
+    }
+}
+
+void InboundDispatcher::dispatch(Channel* channel, std::string&& frame) {
+    std::string shed;
+    bool dropped;
+    {
+        std::lock_guard<std::mutex> lock(poolMtx);
+        dropped = dispatchLocked(*channel, std::move(frame), Clock::now(), shed);
+    }
+    if (dropped && dropHandler) {
+        dropHandler(shed);
+    }
+}
+
+bool InboundDispatcher::dispatchLocked(Channel& channel, std::string&& frame, Clock::time_point now,
+                                       std::string& shed) {
+    channel.received++;
+
+    bool overRate = !takeToken(channel, now);
+    if (workers.empty()) {
+        // Nothing is queued inline, so every policy but sampling drops the newest
+        if (overRate && (policy != Policy::KEEP_EVERY_NTH || ++channel.overBudget % keepEvery != 0)) {
+            channel.dropped++;
+            shed = std::move(frame);
+            return true;
+        }
+        handler(frame);
+        return false;
+    }
+
+    Worker& worker = *workers[channel.hash % workers.size()];
+    bool dropped = false;
+    {
+        std::lock_guard<std::mutex> workerLock(worker.mtx);
+        bool full = queueLimit > 0 && worker.queue.size() >= queueLimit;
+        if (overRate || full) {
+            bool keep;
+            switch (policy) {
+                case Policy::DROP_NEWEST:
+                    keep = false;
+                    break;
+                case Policy::DROP_OLDEST:
+                    // Over the rate, the channel's own stalest frame makes way; when only
+                    // the queue is full, the stalest frame of any channel
+                    keep = dropOldest(worker, overRate ? &channel : nullptr, shed);
+                    break;
+                case Policy::KEEP_EVERY_NTH:
+                default:
+                    keep = ++channel.overBudget % keepEvery == 0 && (!full || dropOldest(worker, nullptr, shed));
+                    break;
+            }
+            if (!keep) {
+                channel.dropped++;
+                shed = std::move(frame);
+                return true;
+            }
+            // Kept by dropping the oldest queued frame to make way for it
+            dropped = policy == Policy::DROP_OLDEST || full;
+        }
+        worker.queue.push_back(Queued{&channel, std::move(frame)});
+        worker.maxDepth = std::max(worker.maxDepth, worker.queue.size());
+    }
+    worker.ready.notify_one();
+    return dropped;
+}
+
+void InboundDispatcher::flush() {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    for (auto& worker : workers) {
+        std::unique_lock<std::mutex> workerLock(worker->mtx);
+        worker->idle.wait(workerLock, [&worker]() { return worker->queue.empty() && !worker->busy; });
+    }
+}
+
+void InboundDispatcher::printStats(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    Clock::time_point now = Clock::now();
+    double seconds = std::chrono::duration<double>(now - reportedAt).count();
+    reportedAt = now;
+
+    // Built first so concurrent output doesn't interleave with the table
+    std::ostringstream table;
+    if (workers.empty()) {
+        table << "Inbound workers: none, frames handled on the socket thread";
+    } else {
+        table << "Inbound workers: " << workers.size() << ", queue limit ";
+        if (queueLimit == 0) {
+            table << "off";
+        } else {
+            table << queueLimit;
+        }
+    }
+    table << ", rate limit ";
+    if (rateLimit <= 0) {
+        table << "off";
+    } else {
+        table << rateLimit << "/s per channel";
+    }
+    table << ", over budget: " << policyName() << std::endl;
+    for (size_t i = 0; i < workers.size(); i++) {
+        Worker& worker = *workers[i];
+        size_t depth;
+        size_t maxDepth;
+        {
+            std::lock_guard<std::mutex> workerLock(worker.mtx);
+            depth = worker.queue.size();
+            maxDepth = worker.maxDepth;
+        }
+        uint64_t processed = worker.processed;
+        double rate = seconds > 0 ? (processed - worker.reportedProcessed) / seconds : 0;
+        worker.reportedProcessed = processed;
+        table << "  worker " << i << ": queued " << depth << " (max " << maxDepth << "), handled "
+              << processed << ", " << static_cast<uint64_t>(rate) << " frames/s since last stats" << std::endl;
+    }
+    for (const auto& kv : channels) {
+        if (kv.second.received == 0) {
+            continue;   // resolved ahead of traffic, e.g. on join
+        }
+        table << "  channel " << kv.first << ": received " << kv.second.received
+              << ", dropped " << kv.second.dropped << std::endl;
+    }
+    out << table.str();
+}
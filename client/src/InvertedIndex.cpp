@@ -0,0 +1,187 @@
+#include "../include/InvertedIndex.h"
+#include <algorithm>
+
+// ============================================
+// Cursor
+// ============================================
+
+InvertedIndex::Cursor::Cursor(const PostingList* list) : list(list), offset(0), read(0), current(0) {
+    next();
+}
+
+bool InvertedIndex::Cursor::valid() const {
+    return read > 0 && read <= list->count;
+}
+
+uint32_t InvertedIndex::Cursor::id() const {
+    return current;
+}
+
+void InvertedIndex::Cursor::next() {
+    if (read == list->count) {
+        // Past the end
+        read = list->count + 1;
+        return;
+    }
+    uint32_t delta = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = list->bytes[offset++];
+        delta |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    current = (read == 0) ? delta : current + delta;
+    read++;
+}
+
+void InvertedIndex::Cursor::advanceTo(uint32_t target) {
+    if (!valid() || current >= target) {
+        return;
+    }
+    // Jump to the last block starting below target, if it is ahead of us
+    auto skip = std::lower_bound(list->skips.begin(), list->skips.end(), target,
+        [](const Skip& s, uint32_t t) { return s.id < t; });
+    if (skip != list->skips.begin()) {
+        --skip;
+        size_t block = skip - list->skips.begin() + 1;
+        if (block * SKIP_INTERVAL > read) {
+            offset = skip->offset;
+            read = static_cast<uint32_t>(block * SKIP_INTERVAL);
+            current = skip->id;
+            next();
+        }
+    }
+    while (valid() && current < target) {
+        next();
+    }
+}
+
+// ============================================
+// InvertedIndex
+// ============================================
+
+InvertedIndex::InvertedIndex() : terms(), postings(0) {}
+
+void InvertedIndex::tokenize(const std::string& text, std::vector<std::string>& out) {
+    std::string word;
+    for (char c : text) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if ((u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || u >= 0x80) {
+            word += c;
+        } else if (u >= 'A' && u <= 'Z') {
+            word += static_cast<char>(u - 'A' + 'a');
+        } else if (!word.empty()) {
+            out.push_back(word);
+            word.clear();
+        }
+    }
+    if (!word.empty()) {
+        out.push_back(word);
+    }
+}
+
+void InvertedIndex::add(uint32_t id, const std::string& text) {
+    std::vector<std::string> words;
+    tokenize(text, words);
+
+    for (const std::string& word : words) {
+        PostingList& list = terms[word];
+        if (list.count > 0 && list.last == id) {
+            continue;   // repeated in this document
+        }
+
+        uint32_t delta = (list.count == 0) ? id : id - list.last;
+        if (list.count > 0 && list.count % SKIP_INTERVAL == 0) {
+            list.skips.push_back(Skip{list.last, static_cast<uint32_t>(list.bytes.size())});
+        }
+        while (delta >= 0x80) {
+            list.bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+            delta >>= 7;
+        }
+        list.bytes.push_back(static_cast<uint8_t>(delta));
+        list.last = id;
+        list.count++;
+        postings++;
+    }
+}
+
+std::vector<uint32_t> InvertedIndex::search(const std::vector<std::string>& words, bool any) const {
+    std::vector<const PostingList*> lists;
+    for (const std::string& text : words) {
+        std::vector<std::string> tokens;
+        tokenize(text, tokens);
+        for (const std::string& token : tokens) {
+            auto it = terms.find(token);
+            if (it != terms.end()) {
+                lists.push_back(&it->second);
+            } else if (!any) {
+                return std::vector<uint32_t>();
+            }
+        }
+    }
+
+    std::vector<uint32_t> result;
+    if (lists.empty()) {
+        return result;
+    }
+
+    if (any) {
+        for (const PostingList* list : lists) {
+            for (Cursor c(list); c.valid(); c.next()) {
+                result.push_back(c.id());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    // Drive the intersection from the shortest list; the others only skip forward
+    std::sort(lists.begin(), lists.end(),
+        [](const PostingList* a, const PostingList* b) { return a->count < b->count; });
+    std::vector<Cursor> cursors;
+    for (const PostingList* list : lists) {
+        cursors.push_back(Cursor(list));
+    }
+
+    Cursor& lead = cursors[0];
+    while (lead.valid()) {
+        uint32_t candidate = lead.id();
+        bool all = true;
+        for (size_t i = 1; i < cursors.size(); i++) {
+            cursors[i].advanceTo(candidate);
+            if (!cursors[i].valid()) {
+                return result;
+            }
+            if (cursors[i].id() != candidate) {
+                // Leap the lead past ids the other list doesn't have
+                lead.advanceTo(cursors[i].id());
+                all = false;
+                break;
+            }
+        }
+        if (all) {
+            result.push_back(candidate);
+            lead.next();
+        }
+    }
+    return result;
+}
+
+size_t InvertedIndex::termCount() const {
+    return terms.size();
+}
+
+size_t InvertedIndex::postingCount() const {
+    return postings;
+}
+
+size_t InvertedIndex::memoryBytes() const {
+    size_t bytes = terms.bucket_count() * sizeof(void*);
+    for (const auto& kv : terms) {
+        bytes += 2 * sizeof(void*) + sizeof(kv) + (kv.first.size() > 15 ? kv.first.capacity() + 1 : 0) +
+                 kv.second.bytes.capacity() + kv.second.skips.capacity() * sizeof(Skip);
+    }
+    return bytes;
+}
@@ -0,0 +1,167 @@
+#include "../include/Lz4.h"
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+static const size_t MIN_MATCH = 4;
+// The last 5 bytes are always literals, and no match starts in the last 12
+static const size_t LAST_LITERALS = 5;
+static const size_t MATCH_FIND_LIMIT = 12;
+static const size_t MAX_OFFSET = 65535;
+// Hash table of up to 2^12 positions, smaller for small inputs so clearing it doesn't
+// dominate the cost of a short body
+static const int MAX_HASH_LOG = 12;
+static const int MIN_HASH_LOG = 8;
+
+static uint32_t read32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint32_t hashOf(uint32_t sequence, int hashLog) {
+    return (sequence * 2654435761u) >> (32 - hashLog);
+}
+
+// A length past the 4 bits of the token, as a run of 255s and a remainder
+static void writeLength(std::string& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+static void writeSequence(std::string& out, const char* literals, size_t literalLength,
+                          size_t offset, size_t matchLength) {
+    size_t token = std::min<size_t>(literalLength, 15) << 4;
+    if (matchLength > 0) {
+        token |= std::min<size_t>(matchLength - MIN_MATCH, 15);
+    }
+    out.push_back(static_cast<char>(token));
+    if (literalLength >= 15) {
+        writeLength(out, literalLength - 15);
+    }
+    out.append(literals, literalLength);
+    if (matchLength == 0) {
+        return;   // the last sequence has literals only
+    }
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (matchLength - MIN_MATCH >= 15) {
+        writeLength(out, matchLength - MIN_MATCH - 15);
+    }
+}
+
+size_t Lz4::compressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+void Lz4::compress(const char* src, size_t size, std::string& out) {
+    out.clear();
+    out.reserve(compressBound(size));
+    size_t anchor = 0;
+    if (size > MATCH_FIND_LIMIT) {
+        int hashLog = MIN_HASH_LOG;
+        while (hashLog < MAX_HASH_LOG && (static_cast<size_t>(1) << (hashLog + 2)) < size) {
+            hashLog++;
+        }
+        // Last position seen for each hashed 4-byte sequence, plus one (0 = none)
+        std::vector<uint32_t> table(static_cast<size_t>(1) << hashLog, 0);
+        size_t matchFindLimit = size - MATCH_FIND_LIMIT;
+        size_t matchLimit = size - LAST_LITERALS;
+        size_t pos = 0;
+        size_t misses = 0;
+        while (pos < matchFindLimit) {
+            uint32_t sequence = read32(src + pos);
+            uint32_t& slot = table[hashOf(sequence, hashLog)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(pos + 1);
+            if (candidate == 0 || pos + 1 - candidate > MAX_OFFSET || read32(src + candidate - 1) != sequence) {
+                // Step further the longer nothing matched, as incompressible data has no matches
+                pos += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+            size_t match = candidate - 1;
+            while (pos > anchor && match > 0 && src[pos - 1] == src[match - 1]) {
+                pos--;
+                match--;
+            }
+            size_t length = MIN_MATCH;
+            while (pos + length < matchLimit && src[pos + length] == src[match + length]) {
+                length++;
+            }
+            writeSequence(out, src + anchor, pos - anchor, pos - match, length);
+            pos += length;
+            anchor = pos;
+            if (pos < matchFindLimit) {
+                table[hashOf(read32(src + pos - 2), hashLog)] = static_cast<uint32_t>(pos - 1);
+            }
+        }
+    }
+    writeSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool Lz4::decompress(const char* src, size_t size, char* dst, size_t dstSize) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    size_t ip = 0;
+    size_t op = 0;
+    while (ip < size) {
+        unsigned token = in[ip++];
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            unsigned char extra;
+            do {
+                if (ip >= size) {
+                    return false;
+                }
+                extra = in[ip++];
+                literalLength += extra;
+            } while (extra == 255);
+        }
+        if (literalLength > size - ip || literalLength > dstSize - op) {
+            return false;
+        }
+        std::memcpy(dst + op, src + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == size) {
+            return op == dstSize;   // the last sequence has no match
+        }
+
+        if (size - ip < 2) {
+            return false;
+        }
+        size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) {
+            return false;
+        }
+        size_t matchLength = token & 15;
+        if (matchLength == 15) {
+            unsigned char extra;
+            do {
+                if (ip >= size) {
+                    return false;
+                }
+                extra = in[ip++];
+                matchLength += extra;
+            } while (extra == 255);
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > dstSize - op) {
+            return false;
+        }
+        if (offset >= matchLength) {
+            std::memcpy(dst + op, dst + op - offset, matchLength);
+        } else {
+            // Overlapping: the match repeats bytes it is itself writing
+            for (size_t i = 0; i < matchLength; i++) {
+                dst[op + i] = dst[op + i - offset];
+            }
+        }
+        op += matchLength;
+    }
+    return false;   // a block ends with a literals-only sequence
+}
@@ -0,0 +1,223 @@
+#include "../include/ReportCache.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <sys/stat.h>
+
+ReportCache::ReportCache() :
+    memoryBudget(64 * 1024 * 1024), memoryUsed(0), spillDir(""),
+    lru(), byPath(), spilled(),
+    hits(0), spillHits(0), misses(0), evictions(0), spills(0), mtx()
+{
+}
+
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+
+static uint64_t fnv1a(const char* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool ReportCache::makeKey(const std::string& path, ReportKey& key) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    // FNV-1a over the file contents
+    uint64_t hash = FNV_OFFSET;
+    char buf[64 * 1024];
+    while (in) {
+        in.read(buf, sizeof(buf));
+        hash = fnv1a(buf, static_cast<size_t>(in.gcount()), hash);
+    }
+
+    key.path = path;
+    key.size = static_cast<long long>(st.st_size);
+    key.mtime = static_cast<long long>(st.st_mtime);
+    key.hash = hash;
+    return true;
+}
+
+size_t ReportCache::sizeOf(const CachedReport& report) {
+    size_t bytes = report.team_a_name.size() + report.team_b_name.size();
+    for (const std::string& body : report.bodies) {
+        bytes += body.size();
+    }
+    return bytes;
+}
+
+bool ReportCache::sameKey(const ReportKey& a, const ReportKey& b) {
+    return a.path == b.path && a.size == b.size && a.mtime == b.mtime && a.hash == b.hash;
+}
+
+bool ReportCache::lookup(const ReportKey& key, CachedReport& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = byPath.find(key.path);
+    if (it != byPath.end()) {
+        if (sameKey(it->second->key, key)) {
+            lru.splice(lru.begin(), lru, it->second);
+            out = it->second->report;
+            hits++;
+            return true;
+        }
+        // File changed since it was cached
+        memoryUsed -= it->second->bytes;
+        lru.erase(it->second);
+        byPath.erase(it);
+    }
+
+    auto sit = spilled.find(key.path);
+    if (sit != spilled.end()) {
+        std::string spillPath = sit->second.second;
+        bool match = sameKey(sit->second.first, key);
+        spilled.erase(sit);
+
+        if (match && readSpill(spillPath, out)) {
+            std::remove(spillPath.c_str());
+            insertFront(key, out);
+            evictToBudget();
+            spillHits++;
+            return true;
+        }
+        std::remove(spillPath.c_str());
+    }
+
+    misses++;
+    return false;
+}
+
+void ReportCache::store(const ReportKey& key, const CachedReport& report) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = byPath.find(key.path);
+    if (it != byPath.end()) {
+        memoryUsed -= it->second->bytes;
+        lru.erase(it->second);
+        byPath.erase(it);
+    }
+    // An older version spilled before must not be read back in place of this one
+    removeSpill(key.path);
+
+    insertFront(key, report);
+    evictToBudget();
+}
+
+void ReportCache::removeSpill(const std::string& path) {
+    auto sit = spilled.find(path);
+    if (sit != spilled.end()) {
+        std::remove(sit->second.second.c_str());
+        spilled.erase(sit);
+    }
+}
+
+void ReportCache::insertFront(const ReportKey& key, const CachedReport& report) {
+    Entry entry{key, report, sizeOf(report)};
+    lru.push_front(entry);
+    byPath[key.path] = lru.begin();
+    memoryUsed += entry.bytes;
+}
+
+void ReportCache::evictToBudget() {
+    while (memoryUsed > memoryBudget && !lru.empty()) {
+        Entry& victim = lru.back();
+
+        std::string spillPath;
+        if (!spillDir.empty() && writeSpill(victim, spillPath)) {
+            spilled[victim.key.path] = std::make_pair(victim.key, spillPath);
+            spills++;
+        }
+
+        memoryUsed -= victim.bytes;
+        byPath.erase(victim.key.path);
+        lru.pop_back();
+        evictions++;
+    }
+}
+
+bool ReportCache::writeSpill(const Entry& entry, std::string& spillPath) {
+    std::ostringstream name;
+    name << spillDir << "/" << std::hex << std::setfill('0')
+         << std::setw(16) << fnv1a(entry.key.path.data(), entry.key.path.size(), FNV_OFFSET) << "-"
+         << std::setw(16) << entry.key.hash << ".rcache";
+    spillPath = name.str();
+
+    std::ofstream out(spillPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    // Length-prefixed records: team a, team b, event count, then every body
+    const CachedReport& report = entry.report;
+    out << report.team_a_name.size() << "\n" << report.team_a_name;
+    out << report.team_b_name.size() << "\n" << report.team_b_name;
+    out << report.bodies.size() << "\n";
+    for (const std::string& body : report.bodies) {
+        out << body.size() << "\n" << body;
+    }
+    return out.good();
+}
+
+bool ReportCache::readSpill(const std::string& spillPath, CachedReport& out) {
+    std::ifstream in(spillPath, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    // Lengths come from the file: a corrupt or truncated one must not size an allocation
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    auto remaining = [&in, size]() { return static_cast<size_t>(size - in.tellg()); };
+
+    auto readField = [&in, &remaining](std::string& field) {
+        size_t len;
+        if (!(in >> len) || in.get() != '\n' || len > remaining()) return false;
+        field.resize(len);
+        in.read(&field[0], len);
+        return static_cast<size_t>(in.gcount()) == len;
+    };
+
+    CachedReport report;
+    size_t count;
+    if (!readField(report.team_a_name) || !readField(report.team_b_name)) return false;
+    // Every body takes at least its "0\n" length line
+    if (!(in >> count) || in.get() != '\n' || count > remaining() / 2) return false;
+
+    report.bodies.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        if (!readField(report.bodies[i])) return false;
+    }
+
+    out = report;
+    return true;
+}
+
+void ReportCache::setMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mtx);
+    memoryBudget = bytes;
+    evictToBudget();
+}
+
+void ReportCache::setSpillDirectory(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(mtx);
+    spillDir = dir;
+}
+
+void ReportCache::printStats(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    out << "Report cache: " << lru.size() << " entries, " << memoryUsed << "/" << memoryBudget << " bytes, "
+        << spilled.size() << " spilled" << std::endl;
+    out << "  hits: " << hits << " (spill: " << spillHits << "), misses: " << misses
+        << ", evictions: " << evictions << ", spills: " << spills << std::endl;
+}
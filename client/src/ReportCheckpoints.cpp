@@ -0,0 +1,73 @@
+#include "../include/ReportCheckpoints.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+ReportCheckpoints::ReportCheckpoints() :
+    checkpointPath(".report_checkpoints"), checkpoints(), loaded(false), mtx()
+{
+}
+
+void ReportCheckpoints::setPath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx);
+    checkpointPath = path;
+    checkpoints.clear();
+    loaded = false;
+}
+
+void ReportCheckpoints::loadLocked() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    std::ifstream in(checkpointPath);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        size_t acked;
+        uint64_t hash;
+        std::string file;
+        if (fields >> acked >> std::hex >> hash >> std::ws && std::getline(fields, file)) {
+            checkpoints[file] = Checkpoint{hash, acked};
+        }
+    }
+}
+
+void ReportCheckpoints::saveLocked() {
+    // Write then rename, so a crash never leaves a half-written checkpoint file
+    std::string tmpPath = checkpointPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        for (const auto& kv : checkpoints) {
+            out << std::dec << kv.second.acked << " " << std::hex << kv.second.hash << " " << kv.first << "\n";
+        }
+        if (!out.good()) {
+            return;
+        }
+    }
+    std::rename(tmpPath.c_str(), checkpointPath.c_str());
+}
+
+size_t ReportCheckpoints::acknowledged(const std::string& file, uint64_t hash) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadLocked();
+
+    auto it = checkpoints.find(file);
+    if (it == checkpoints.end() || it->second.hash != hash) {
+        return 0;
+    }
+    return it->second.acked;
+}
+
+void ReportCheckpoints::record(const std::string& file, uint64_t hash, size_t acked) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadLocked();
+
+    auto it = checkpoints.find(file);
+    if (it != checkpoints.end() && it->second.hash == hash && it->second.acked >= acked) {
+        return;
+    }
+    checkpoints[file] = Checkpoint{hash, acked};
+    saveLocked();
+}
@@ -0,0 +1,198 @@
+#include "../include/ReportFollower.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+
+ReportFollower::ReportFollower(EventCallback callback) :
+    onEvent(callback), inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+    wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), files(), stopping(false), mtx(), worker()
+{
+    worker = std::thread(&ReportFollower::run, this);
+}
+
+ReportFollower::~ReportFollower() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wake();
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    for (auto& kv : files) {
+        ::close(kv.second.fd);
+    }
+    if (inotifyFd >= 0) ::close(inotifyFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+}
+
+void ReportFollower::wake() {
+    uint64_t one = 1;
+    if (::write(wakeFd, &one, sizeof(one)) < 0) {
+        // Counter already pending; the thread will wake anyway
+    }
+}
+
+bool ReportFollower::follow(const std::string& path, std::string& error) {
+    if (inotifyFd < 0 || wakeFd < 0) {
+        error = "inotify is not available";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (const auto& kv : files) {
+        if (kv.second.path == path) {
+            error = "already following " + path;
+            return false;
+        }
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+
+    int watch = inotify_add_watch(inotifyFd, path.c_str(), IN_MODIFY | IN_CLOSE_WRITE);
+    if (watch < 0) {
+        error = std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    // inotify has one watch per inode, so another path to a followed file gets its watch back
+    auto existing = files.find(watch);
+    if (existing != files.end()) {
+        error = "already following " + path + " as " + existing->second.path;
+        ::close(fd);
+        return false;
+    }
+
+    files.insert(std::make_pair(watch, FollowedFile(path, fd)));
+
+    // The thread reads whatever the file already holds as soon as it wakes
+    wake();
+    return true;
+}
+
+bool ReportFollower::unfollow(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (auto it = files.begin(); it != files.end(); ++it) {
+        if (it->second.path == path) {
+            inotify_rm_watch(inotifyFd, it->first);
+            ::close(it->second.fd);
+            files.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReportFollower::run() {
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (true) {
+        struct pollfd fds[2];
+        fds[0].fd = inotifyFd;
+        fds[0].events = POLLIN;
+        fds[1].fd = wakeFd;
+        fds[1].events = POLLIN;
+
+        if (::poll(fds, 2, -1) < 0 && errno != EINTR) {
+            return;
+        }
+
+        // Only read and parse under the lock: the callback sends, and may block
+        std::vector<ReadyEvent> ready;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (stopping) {
+                return;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                uint64_t count;
+                if (::read(wakeFd, &count, sizeof(count)) > 0) {
+                    for (auto& kv : files) {
+                        readAppended(kv.second, ready);
+                    }
+                }
+            }
+
+            if (fds[0].revents & POLLIN) {
+                ssize_t len;
+                while ((len = ::read(inotifyFd, buf, sizeof(buf))) > 0) {
+                    for (char* p = buf; p < buf + len;) {
+                        struct inotify_event* event = reinterpret_cast<struct inotify_event*>(p);
+                        auto it = files.find(event->wd);
+                        if (it != files.end()) {
+                            readAppended(it->second, ready);
+                        }
+                        p += sizeof(struct inotify_event) + event->len;
+                    }
+                }
+            }
+        }
+
+        for (const ReadyEvent& ready_event : ready) {
+            onEvent(ready_event.team_a_name, ready_event.team_b_name, ready_event.event);
+        }
+    }
+}
+
+void ReportFollower::readAppended(FollowedFile& file, std::vector<ReadyEvent>& ready) {
+    struct stat st;
+    if (::fstat(file.fd, &st) == 0 && st.st_size < file.offset) {
+        // Truncated or rewritten: start over, header included
+        ::lseek(file.fd, 0, SEEK_SET);
+        file.offset = 0;
+        file.partial.clear();
+        file.hasHeader = false;
+    }
+
+    char buf[64 * 1024];
+    ssize_t n;
+    while ((n = ::read(file.fd, buf, sizeof(buf))) > 0) {
+        file.offset += n;
+        file.partial.append(buf, static_cast<size_t>(n));
+    }
+
+    size_t start = 0;
+    size_t newline;
+    while ((newline = file.partial.find('\n', start)) != std::string::npos) {
+        size_t end = newline;
+        if (end > start && file.partial[end - 1] == '\r') {
+            end--;
+        }
+        processLine(file, file.partial.substr(start, end - start), ready);
+        start = newline + 1;
+    }
+    file.partial.erase(0, start);
+}
+
+void ReportFollower::processLine(FollowedFile& file, const std::string& line, std::vector<ReadyEvent>& ready) {
+    if (line.find_first_not_of(" \t") == std::string::npos) {
+        return;
+    }
+
+    try {
+        if (!file.hasHeader) {
+            parseEventsHeaderLine(line, file.team_a_name, file.team_b_name);
+            file.hasHeader = true;
+            return;
+        }
+        ready.push_back(ReadyEvent(file.team_a_name, file.team_b_name,
+                                   parseEventLine(line, file.team_a_name, file.team_b_name)));
+    } catch (const std::exception& e) {
+        std::cout << "Skipping malformed line in " << file.path << ": " << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,71 @@
+#include "../include/SavedSubscriptions.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+SavedSubscriptions::SavedSubscriptions() :
+    savedPath(".subscriptions"), channels(), loaded(false), mtx()
+{
+}
+
+void SavedSubscriptions::setPath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx);
+    savedPath = path;
+    channels.clear();
+    loaded = false;
+}
+
+void SavedSubscriptions::loadLocked() {
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    std::ifstream in(savedPath);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string user;
+        std::string channel;
+        if (fields >> user >> channel) {
+            channels[user].push_back(channel);
+        }
+    }
+}
+
+void SavedSubscriptions::saveLocked() {
+    // Write then rename, so a crash never leaves a half-written list
+    std::string tmpPath = savedPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        for (const auto& kv : channels) {
+            for (const std::string& channel : kv.second) {
+                out << kv.first << " " << channel << "\n";
+            }
+        }
+        if (!out.good()) {
+            return;
+        }
+    }
+    std::rename(tmpPath.c_str(), savedPath.c_str());
+}
+
+std::vector<std::string> SavedSubscriptions::load(const std::string& user) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadLocked();
+
+    auto it = channels.find(user);
+    return it == channels.end() ? std::vector<std::string>() : it->second;
+}
+
+void SavedSubscriptions::save(const std::string& user, const std::vector<std::string>& userChannels) {
+    std::lock_guard<std::mutex> lock(mtx);
+    loadLocked();
+
+    if (userChannels.empty()) {
+        channels.erase(user);
+    } else {
+        channels[user] = userChannels;
+    }
+    saveLocked();
+}
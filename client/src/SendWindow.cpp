@@ -0,0 +1,108 @@
+#include "../include/SendWindow.h"
+#include <algorithm>
+
+SendWindow::SendWindow() :
+    enabled(false), closed(false), receiptEvery(16), window(64), minWindow(1), maxWindow(4096),
+    sentSeq(0), ackedSeq(0), sinceReceipt(0), pending(),
+    smoothedRtt(0), minRtt(0), receiptLatency(), mtx(), acked()
+{
+}
+
+void SendWindow::setWindow(size_t initialWindow) {
+    std::lock_guard<std::mutex> lock(mtx);
+    enabled = initialWindow > 0;
+    if (enabled) {
+        window = initialWindow;
+    }
+    acked.notify_all();
+}
+
+void SendWindow::setReceiptEvery(size_t frames) {
+    std::lock_guard<std::mutex> lock(mtx);
+    receiptEvery = frames > 0 ? frames : 1;
+}
+
+bool SendWindow::acquire(bool& wantReceipt) {
+    std::unique_lock<std::mutex> lock(mtx);
+    wantReceipt = false;
+    if (!enabled) {
+        return !closed;
+    }
+
+    acked.wait(lock, [this]() { return closed || !enabled || sentSeq - ackedSeq < window; });
+    if (closed) {
+        return false;
+    }
+
+    sentSeq++;
+    sinceReceipt++;
+    // Also ask when this frame fills the window, or nothing would ever reopen it
+    if (enabled && (sinceReceipt >= receiptEvery || sentSeq - ackedSeq >= window)) {
+        wantReceipt = true;
+        sinceReceipt = 0;
+    }
+    return true;
+}
+
+void SendWindow::track(int receiptId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    pending.insert(std::make_pair(receiptId, PendingReceipt(sentSeq, Clock::now())));
+}
+
+bool SendWindow::onReceipt(int receiptId) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = pending.find(receiptId);
+    if (it == pending.end()) {
+        return false;
+    }
+
+    double rtt = std::chrono::duration<double, std::micro>(Clock::now() - it->second.sentAt).count();
+    receiptLatency.record(static_cast<uint64_t>(rtt));
+    ackedSeq = std::max(ackedSeq, it->second.seq);
+    pending.erase(it);
+
+    adapt(rtt);
+    acked.notify_all();
+    return true;
+}
+
+void SendWindow::adapt(double rtt) {
+    if (minRtt == 0 || rtt < minRtt) {
+        minRtt = rtt;
+    }
+    smoothedRtt = smoothedRtt == 0 ? rtt : 0.875 * smoothedRtt + 0.125 * rtt;
+
+    // Delay-based: round trips close to the best observed mean the broker keeps up,
+    // so open up by one receipt's worth; stretched round trips mean frames are queueing
+    if (smoothedRtt < 2 * minRtt) {
+        window = std::min(maxWindow, window + receiptEvery);
+    } else if (smoothedRtt > 4 * minRtt) {
+        window = std::max(minWindow, window * 3 / 4);
+    }
+}
+
+void SendWindow::close() {
+    std::lock_guard<std::mutex> lock(mtx);
+    closed = true;
+    acked.notify_all();
+}
+
+void SendWindow::reset() {
+    std::lock_guard<std::mutex> lock(mtx);
+    closed = false;
+    sentSeq = 0;
+    ackedSeq = 0;
+    sinceReceipt = 0;
+    pending.clear();
+    smoothedRtt = 0;
+    minRtt = 0;
+}
+
+void SendWindow::printStats(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mtx);
+    out << "Send window: " << (enabled ? "on" : "off") << ", in flight " << (sentSeq - ackedSeq)
+        << "/" << window << " frames, receipt every " << receiptEvery
+        << ", smoothed rtt " << static_cast<uint64_t>(smoothedRtt) << "us" << std::endl;
+    receiptLatency.print(out, "Receipt latency", "us");
+}
@@ -0,0 +1,183 @@
+#include "../include/ShardedEventStore.h"
+
+ShardedEventStore::Shard::Shard(const std::string& game) :
+    game(game), storeMtx(), store(std::make_shared<GameEventStore>()), pendingMtx(), pending(), rawBodies(), rawCount(0)
+{
+}
+
+ShardedEventStore::ShardedEventStore() :
+    directory(std::make_shared<const Directory>()), directoryMtx(), checkpointInterval(256)
+{
+}
+
+std::shared_ptr<ShardedEventStore::Shard> ShardedEventStore::findShard(const std::string& game) const {
+    std::shared_ptr<const Directory> current = std::atomic_load(&directory);
+    auto it = current->find(game);
+    return it == current->end() ? nullptr : it->second;
+}
+
+std::shared_ptr<ShardedEventStore::Shard> ShardedEventStore::getOrCreateShard(const std::string& game) {
+    std::shared_ptr<Shard> shard = findShard(game);
+    if (shard) {
+        return shard;
+    }
+
+    std::lock_guard<std::mutex> lock(directoryMtx);
+    std::shared_ptr<const Directory> current = std::atomic_load(&directory);
+    auto it = current->find(game);
+    if (it != current->end()) {
+        return it->second;   // created while we waited
+    }
+
+    shard = std::make_shared<Shard>(game);
+    shard->store->setCheckpointInterval(checkpointInterval);
+    std::shared_ptr<Directory> next = std::make_shared<Directory>(*current);
+    (*next)[game] = shard;
+    std::atomic_store(&directory, std::shared_ptr<const Directory>(next));
+    return shard;
+}
+
+GameEventStore& ShardedEventStore::writableStore(Shard& shard) {
+    // Readers only take references under storeMtx, so a count of one can't go up meanwhile
+    if (shard.store.use_count() > 1) {
+        shard.store = std::make_shared<GameEventStore>(*shard.store);
+    }
+    return *shard.store;
+}
+
+std::shared_ptr<const GameEventStore> ShardedEventStore::fold(Shard& shard) {
+    std::vector<PendingEvent> batch;
+    std::string rawBodies;
+    {
+        std::lock_guard<std::mutex> lock(shard.pendingMtx);
+        batch.swap(shard.pending);
+        rawBodies.swap(shard.rawBodies);
+        shard.rawCount = 0;
+    }
+    if (!batch.empty()) {
+        GameEventStore& store = writableStore(shard);
+        for (const PendingEvent& p : batch) {
+            if (p.event) {
+                store.add(shard.game, p.user, *p.event);
+            } else {
+                store.add(shard.game, p.user, Event(rawBodies.substr(p.rawOffset, p.rawLength)));
+            }
+        }
+    }
+    return shard.store;
+}
+
+void ShardedEventStore::add(const std::string& game, const std::string& user, const Event& event) {
+    std::shared_ptr<Shard> shard = getOrCreateShard(game);
+
+    size_t pending;
+    {
+        std::lock_guard<std::mutex> lock(shard->pendingMtx);
+        shard->pending.push_back(PendingEvent{user, std::unique_ptr<Event>(new Event(event)), 0, 0});
+        pending = shard->pending.size();
+    }
+
+    // Keep the pending list short when nobody reads, without waiting for another fold
+    if (pending >= FOLD_THRESHOLD && shard->storeMtx.try_lock()) {
+        std::lock_guard<std::mutex> lock(shard->storeMtx, std::adopt_lock);
+        fold(*shard);
+    }
+}
+
+void ShardedEventStore::addRaw(const std::string& game, const std::string& user, const char* body, size_t length) {
+    std::shared_ptr<Shard> shard = getOrCreateShard(game);
+    std::lock_guard<std::mutex> lock(shard->pendingMtx);
+    shard->pending.push_back(PendingEvent{user, nullptr, shard->rawBodies.size(), length});
+    shard->rawBodies.append(body, length);
+    shard->rawCount++;
+    // Never folds: decoding waits for a reader
+}
+
+bool ShardedEventStore::hasGame(const std::string& game) const {
+    return findShard(game) != nullptr;
+}
+
+bool ShardedEventStore::read(const std::string& game, const std::function<void(const GameEventStore&)>& reader) {
+    std::shared_ptr<Shard> shard = findShard(game);
+    if (!shard) {
+        return false;
+    }
+    std::shared_ptr<const GameEventStore> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(shard->storeMtx);
+        snapshot = fold(*shard);
+    }
+    reader(*snapshot);
+    return true;
+}
+
+void ShardedEventStore::readAll(const std::function<void(const std::string&, const GameEventStore&)>& reader) {
+    std::shared_ptr<const Directory> current = std::atomic_load(&directory);
+    for (const auto& kv : *current) {
+        std::shared_ptr<const GameEventStore> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(kv.second->storeMtx);
+            snapshot = fold(*kv.second);
+        }
+        reader(kv.first, *snapshot);
+    }
+}
+
+void ShardedEventStore::setCheckpointInterval(size_t interval) {
+    std::lock_guard<std::mutex> lock(directoryMtx);
+    checkpointInterval = interval;
+    std::shared_ptr<const Directory> current = std::atomic_load(&directory);
+    for (const auto& kv : *current) {
+        std::lock_guard<std::mutex> storeLock(kv.second->storeMtx);
+        writableStore(*kv.second).setCheckpointInterval(interval);
+    }
+}
+
+void ShardedEventStore::printStats(std::ostream& out) {
+    size_t games = 0;
+    size_t events = 0;
+    size_t bytes = 0;
+    size_t checkpointBytes = 0;
+    size_t terms = 0;
+    size_t postings = 0;
+    size_t indexBytes = 0;
+    size_t pending = 0;
+    size_t raw = 0;
+    size_t pendingBytes = 0;
+    // Without folding, so stats never decode raw events
+    std::shared_ptr<const Directory> current = std::atomic_load(&directory);
+    for (const auto& kv : *current) {
+        Shard& shard = *kv.second;
+        {
+            std::shared_ptr<const GameEventStore> store;
+            {
+                std::lock_guard<std::mutex> lock(shard.storeMtx);
+                store = shard.store;
+            }
+            games++;
+            events += store->eventCount();
+            bytes += store->memoryBytes();
+            checkpointBytes += store->checkpointMemoryBytes();
+            terms += store->searchTermCount();
+            postings += store->searchPostingCount();
+            indexBytes += store->textIndexMemoryBytes();
+        }
+        std::lock_guard<std::mutex> lock(shard.pendingMtx);
+        pending += shard.pending.size();
+        raw += shard.rawCount;
+        pendingBytes += shard.rawBodies.capacity() + shard.pending.capacity() * sizeof(PendingEvent);
+    }
+
+    size_t interval = checkpointInterval;
+    out << "Event store: " << games << " games, " << events << " events, " << bytes / 1024 << " KB"
+        << ", summary checkpoints " << checkpointBytes / 1024 << " KB";
+    if (interval == 0) {
+        out << " (disabled)" << std::endl;
+    } else {
+        out << " (every " << interval << " events)" << std::endl;
+    }
+    out << "  search index: " << terms << " terms, " << postings << " postings, "
+        << indexBytes / 1024 << " KB" << std::endl;
+    out << "  pending: " << pending << " events (" << raw << " undecoded), "
+        << pendingBytes / 1024 << " KB" << std::endl;
+}
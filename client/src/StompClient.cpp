@@ -12,10 +12,9 @@ int main(int argc, char *argv[]) {
     
     // Main thread: keyboard input
     while (true) {
-        const short bufsize = 1024;
-        char buf[bufsize];
-        std::cin.getline(buf, bufsize);
-        std::string line(buf);
+        // Unbounded: a bulk join or exit can name thousands of channels
+        std::string line;
+        std::getline(std::cin, line);
         
         // Check if this is a login command and we're not connected yet
         if (line.find("login ") == 0 && !protocol.isClientConnected() && connectionHandler == nullptr) {
@@ -25,7 +24,7 @@ int main(int argc, char *argv[]) {
             iss >> cmd >> hostPort >> username >> password;
             
             if (hostPort.empty()) {
-                std::cout << "Usage: login {host:port} {username} {password}" << std::endl;
+                std::cout << "Usage: login {host:port} {username} {password} [--restore]" << std::endl;
                 continue;
             }
             
@@ -54,15 +53,17 @@ int main(int argc, char *argv[]) {
             // Start socket listener thread
             socketThread = new std::thread([connectionHandler, &protocol]() {
                 while (true) {
-                    std::string answer;
+                    std::vector<std::string> answers;
+                    std::vector<std::chrono::system_clock::time_point> receivedAt;
                     
-                    if (!connectionHandler->getFrameAscii(answer, '\0')) {
+                    if (!connectionHandler->getFrames(answers, '\0', &receivedAt)) {
                         std::cout << "Disconnected from server." << std::endl;
                         protocol.close();
                         break;
                     }
                     
-                    bool shouldContinue = protocol.handleServerFrame(answer);
+                    // Framing only: the protocol sorts the batch into control and data lanes
+                    bool shouldContinue = protocol.receiveFrames(answers, receivedAt);
                     if (!shouldContinue) {
                         break;
                     }
@@ -84,6 +85,7 @@ int main(int argc, char *argv[]) {
     }
     
     if (connectionHandler != nullptr) {
+        protocol.setConnectionHandler(nullptr);
         delete connectionHandler;
     }
     
@@ -2,36 +2,166 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <limits>
 #include <algorithm>
 #include <mutex>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <stdexcept>
 
 StompProtocol::StompProtocol() :
-    handler(nullptr), shouldTerminate(false), isConnected(false),
-    currentUserName(""), subscriptionIdCounter(0), receiptIdCounter(0),
-    subscriptions(), receiptActions(), gameEvents(), mtx()
+    handler(nullptr), shouldTerminate(false), isConnected(false), currentUserName(""), checkpointInterval(50), lazyDecoding(false),
+    sessionMarker(), kernelTimestamps(false), heartBeatSendMs(10000), heartBeatReceiveMs(10000),
+    subscriptionIdCounter(0), subscriptions(), connectPending(false), pendingSubscriptions(),
+    savedSubscriptions(), receiptIdCounter(0), receiptActions(), reportReceipts(),
+    eventStore(), reportCache(), reportCheckpoints(), paceSkew(), sendWindow(), selfEchoesDropped(0), echoLatency(), subscriptionMonitor(),
+    compression(),
+    stateMtx(), subscriptionMtx(), receiptMtx(), sendMtx(), acks([this]() { flushAcks(); }), paceTimers(),
+    reportFollower([this](const std::string& team_a, const std::string& team_b, const Event& event) {
+        handleFollowedEvent(team_a, team_b, event);
+    }),
+    inbound([this](const std::string& frame) {
+                handleMessage(frame);
+                if (acks.onHandled(frame)) {
+                    flushAcks();
+                }
+            },
+            std::min(4u, std::max(1u, std::thread::hardware_concurrency())),
+            // Shed under load, but still acknowledged, or the broker keeps it outstanding
+            [this](const std::string& frame) {
+                if (acks.onDropped(frame)) {
+                    flushAcks();
+                }
+            }),
+    heartBeat()
 {
 }
 
 void StompProtocol::setConnectionHandler(ConnectionHandler* h) {
+    bool timestamps;
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        timestamps = kernelTimestamps;
+    }
+    if (h != nullptr && timestamps) {
+        h->enableReceiveTimestamps();
+    }
+    // The heart-beat callbacks hold the current handler
+    heartBeat.stop();
+    std::lock_guard<std::mutex> lock(sendMtx);
     handler = h;
 }
 
+bool StompProtocol::sendFrame(const Frame& frame) {
+    std::string wire = frame.toString();
+    std::lock_guard<std::mutex> lock(sendMtx);
+    if (handler == nullptr) {
+        return false;
+    }
+    std::string waitingAcks;
+    if (acks.drain(waitingAcks, true) > 0) {
+        wire.insert(0, waitingAcks);
+    }
+    return handler->sendFrameAscii(wire, '\0');
+}
+
+bool StompProtocol::sendFrames(const std::vector<Frame>& frames) {
+    std::string batch;
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (i > 0) {
+            batch += '\0';
+        }
+        batch += frames[i].toString();
+    }
+    std::lock_guard<std::mutex> lock(sendMtx);
+    if (handler == nullptr) {
+        return false;
+    }
+    std::string waitingAcks;
+    if (acks.drain(waitingAcks, true) > 0) {
+        batch.insert(0, waitingAcks);
+    }
+    return handler->sendFrameAscii(batch, '\0');
+}
+
+void StompProtocol::flushAcks() {
+    std::string wire;
+    std::lock_guard<std::mutex> lock(sendMtx);
+    if (handler != nullptr && acks.drain(wire, false) > 0) {
+        handler->sendBytes(wire.data(), wire.size());
+    }
+}
+
+Frame StompProtocol::buildSendFrame(const std::string& game_name, const std::string& body) {
+    Frame frame("SEND");
+    frame.addHeader("destination", "/" + game_name);
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        frame.addHeader("sender-session", sessionMarker);
+    }
+    echoLatency.stamp(frame);
+    frame.setBody(body);
+    compression.encode(frame);
+    return frame;
+}
+
 void StompProtocol::close() {
-    std::lock_guard<std::mutex> lock(mtx);
-    shouldTerminate = true;
-    isConnected = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        shouldTerminate = true;
+        isConnected = false;
+    }
+    heartBeat.stop();
+    acks.reset();
+    sendWindow.close();
 }
 
 bool StompProtocol::shouldLogout() const {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::lock_guard<std::mutex> lock(stateMtx);
     return shouldTerminate;
 }
 
 bool StompProtocol::isClientConnected() const {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::lock_guard<std::mutex> lock(stateMtx);
     return isConnected;
 }
 
+std::string StompProtocol::getCurrentUserName() const {
+    std::lock_guard<std::mutex> lock(stateMtx);
+    return currentUserName;
+}
+
+bool StompProtocol::isDisconnectReceipt(const std::string& receiptId) {
+    int id;
+    try {
+        id = std::stoi(receiptId);
+    } catch (const std::exception& e) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(receiptMtx);
+    auto it = receiptActions.find(id);
+    return it != receiptActions.end() && it->second == "DISCONNECT";
+}
+
+const std::string* StompProtocol::subscriptionOf(const std::string& frameStr) const {
+    uint64_t id;
+    if (!Frame::peekNumber(frameStr, "subscription", id)) {
+        return nullptr;
+    }
+    return subscriptionMonitor.destination(id);
+}
+
+bool StompProtocol::isConnectPending() {
+    std::lock_guard<std::mutex> lock(subscriptionMtx);
+    return connectPending;
+}
+
+bool StompProtocol::isSubscribed(const std::string& game_name) {
+    std::lock_guard<std::mutex> lock(subscriptionMtx);
+    return subscriptions.find(game_name) != subscriptions.end();
+}
+
 std::vector<std::string> StompProtocol::split(const std::string& str, char delimiter) {
     std::vector<std::string> tokens;
     std::string token;
@@ -49,6 +179,11 @@ UserCommand StompProtocol::parseUserCommand(const std::string& cmd) {
     if (cmd == "logout") return UserCommand::LOGOUT;
     if (cmd == "report") return UserCommand::REPORT;
     if (cmd == "summary") return UserCommand::SUMMARY;
+    if (cmd == "query") return UserCommand::QUERY;
+    if (cmd == "search") return UserCommand::SEARCH;
+    if (cmd == "latency") return UserCommand::LATENCY;
+    if (cmd == "config") return UserCommand::CONFIG;
+    if (cmd == "stats") return UserCommand::STATS;
     return UserCommand::UNKNOWN;
 }
 
@@ -66,12 +201,7 @@ void StompProtocol::executeUserCommand(const std::string& line) {
     
     UserCommand cmd = parseUserCommand(args[0]);
     
-    // Check connection status with lock
-    bool connected;
-    {
-        std::lock_guard<std::mutex> lock(mtx);
-        connected = isConnected;
-    }
+    bool connected = isClientConnected();
     
     switch (cmd) {
         case UserCommand::LOGIN:
@@ -79,7 +209,8 @@ void StompProtocol::executeUserCommand(const std::string& line) {
             break;
             
         case UserCommand::JOIN:
-            if (!connected) {
+            // Allowed while the login is in flight, pipelined behind the CONNECT
+            if (!connected && !isConnectPending()) {
                 std::cout << "Please login first" << std::endl;
                 return;
             }
@@ -87,7 +218,8 @@ void StompProtocol::executeUserCommand(const std::string& line) {
             break;
             
         case UserCommand::EXIT:
-            if (!connected) {
+            // Allowed while the login is in flight, pipelined behind the CONNECT
+            if (!connected && !isConnectPending()) {
                 std::cout << "Please login first" << std::endl;
                 return;
             }
@@ -118,20 +250,107 @@ void StompProtocol::executeUserCommand(const std::string& line) {
             handleSummary(args);
             break;
             
+        case UserCommand::QUERY:
+            if (!connected) {
+                std::cout << "Please login first" << std::endl;
+                return;
+            }
+            handleQuery(args);
+            break;
+            
+        case UserCommand::SEARCH:
+            if (!connected) {
+                std::cout << "Please login first" << std::endl;
+                return;
+            }
+            handleSearch(args);
+            break;
+            
+        case UserCommand::LATENCY:
+            handleLatency(args);
+            break;
+            
+        case UserCommand::CONFIG:
+            handleConfig(args);
+            break;
+            
+        case UserCommand::STATS:
+            handleStats();
+            break;
+            
         case UserCommand::UNKNOWN:
             break;
     }
 }
 
+bool StompProtocol::receiveFrames(std::vector<std::string>& frames,
+                                  const std::vector<std::chrono::system_clock::time_point>& receivedAt) {
+    std::string marker;
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        marker = sessionMarker;
+    }
+    
+    // Control lane: handled now, ahead of any MESSAGE backlog in the batch
+    std::vector<std::string*> data;
+    std::string* ending = nullptr;
+    for (size_t i = 0; i < frames.size(); i++) {
+        std::string& frame = frames[i];
+        std::string command = Frame::peekCommand(frame);
+        if (command == "MESSAGE") {
+            subscriptionMonitor.onReceived(frame);
+            // Our own reports come back too; drop them on the header alone, after
+            // timing their round trip
+            if (!marker.empty() && Frame::peekHeader(frame, "sender-session") == marker) {
+                echoLatency.onEcho(frame, i < receivedAt.size() ? receivedAt[i] : std::chrono::system_clock::time_point());
+                selfEchoesDropped++;
+                if (acks.onDropped(frame)) {
+                    flushAcks();
+                }
+                continue;
+            }
+            data.push_back(&frame);
+        } else if (command == "ERROR" || (command == "RECEIPT" && isDisconnectReceipt(Frame::peekHeader(frame, "receipt-id")))) {
+            ending = &frame;
+            break;   // nothing after it is handled
+        } else {
+            handleServerFrame(frame);
+        }
+    }
+    
+    // Data lane, routed by the subscription header
+    for (std::string* frame : data) {
+        uint64_t id;
+        InboundDispatcher::Channel* route =
+            Frame::peekNumber(*frame, "subscription", id) ? subscriptionMonitor.route(id) : nullptr;
+        if (route != nullptr) {
+            inbound.dispatch(route, std::move(*frame));
+        } else {
+            inbound.dispatch(Frame::peekHeader(*frame, "destination"), std::move(*frame));
+        }
+    }
+    
+    if (ending != nullptr) {
+        // The session ends only after the messages received before it
+        inbound.flush();
+        return handleServerFrame(*ending);
+    }
+    return true;
+}
+
 bool StompProtocol::handleServerFrame(const std::string& frameStr) {
     Frame frame = Frame::parse(frameStr);
     ServerCommand cmd = parseServerCommand(frame.getCommand());
     
     switch (cmd) {
         case ServerCommand::CONNECTED: {
-            std::lock_guard<std::mutex> lock(mtx);
-            isConnected = true;
-            std::cout << "Login successful" << std::endl;
+            {
+                std::lock_guard<std::mutex> lock(stateMtx);
+                isConnected = true;
+                std::cout << "Login successful" << std::endl;
+            }
+            startHeartBeat(frame.getHeader("heart-beat"));
+            settlePendingSubscriptions(true);
             break;
         }
             
@@ -143,22 +362,44 @@ bool StompProtocol::handleServerFrame(const std::string& frameStr) {
             if (!body.empty()) {
                 std::cout << body << std::endl;
             }
+            settlePendingSubscriptions(false);
             
             close();
             return false;
         }
             
         case ServerCommand::RECEIPT: {
-            std::lock_guard<std::mutex> lock(mtx);
             int id = std::stoi(frame.getHeader("receipt-id"));
             
-            if (receiptActions.find(id) != receiptActions.end()) {
-                std::string action = receiptActions[id];
-                receiptActions.erase(id);
-                
-                // Unlock before I/O and close() which will re-lock
-                lock.~lock_guard();
-                
+            bool hasAction = false;
+            std::string action;
+            bool isReportReceipt = false;
+            ReportReceipt checkpoint;
+            {
+                std::lock_guard<std::mutex> lock(receiptMtx);
+                auto it = receiptActions.find(id);
+                if (it != receiptActions.end()) {
+                    hasAction = true;
+                    action = it->second;
+                    receiptActions.erase(it);
+                }
+                auto rit = reportReceipts.find(id);
+                if (rit != reportReceipts.end()) {
+                    isReportReceipt = true;
+                    checkpoint = rit->second;
+                    reportReceipts.erase(rit);
+                }
+            }
+            
+            // I/O and close() happen outside the lock, close() re-locks
+            if (isReportReceipt) {
+                sendWindow.onReceipt(id);
+                if (checkpoint.checkpoint) {
+                    reportCheckpoints.record(checkpoint.file, checkpoint.hash, checkpoint.acked);
+                }
+            }
+            
+            if (hasAction) {
                 if (action == "DISCONNECT") {
                     std::cout << "Disconnected properly." << std::endl;
                     close();
@@ -170,12 +411,72 @@ bool StompProtocol::handleServerFrame(const std::string& frameStr) {
             break;
         }
             
-        case ServerCommand::MESSAGE: {
-            std::string body = frame.getBody();
-            Event event(body);
+        case ServerCommand::MESSAGE:
+            handleMessage(frameStr);
+            break;
+            
+        case ServerCommand::UNKNOWN:
+            break;
+    }
+    
+    return true;
+}
+
+void StompProtocol::handleMessage(const std::string& received) {
+    subscriptionMonitor.onHandled(received);
+    
+    // A compressed body is decompressed here, on the worker, and the rest reads the plain frame
+    std::string decoded;
+    FrameCompression::Result decoding = compression.decode(received, decoded);
+    if (decoding == FrameCompression::Result::FAILED) {
+        std::cout << ("Dropped a message with an undecodable " + Frame::peekHeader(received, "content-encoding")
+                      + " body in " + Frame::peekHeader(received, "destination") + "\n") << std::flush;
+        return;
+    }
+    const std::string& frameStr = decoding == FrameCompression::Result::DECODED ? decoded : received;
+    
+    std::string currentUser;
+    bool lazy;
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        currentUser = currentUserName;
+        lazy = lazyDecoding;
+    }
+    
+    // Routed by the subscription; the team names in the body are the fallback
+    const std::string* destination = subscriptionOf(frameStr);
+    std::string channel = destination != nullptr ? destination->substr(1) : "";
+    // A batched report packs several events into one body; each is handled as if it came alone
+    uint64_t eventCount;
+    bool batched = Frame::peekNumber(frameStr, "event-count", eventCount);
+    if (lazy) {
+        // Only the routing lines; the body is stored as received
+        size_t bodyStart = Frame::peekBodyOffset(frameStr);
+        std::vector<std::pair<size_t, size_t>> events = batched ? splitEventBatch(frameStr, bodyStart)
+            : std::vector<std::pair<size_t, size_t>>(1, std::make_pair(bodyStart, frameStr.size()));
+        for (const auto& range : events) {
+            std::string user;
+            std::string team_a;
+            std::string team_b;
+            peekEventRouting(frameStr, range.first, user, team_a, team_b);
+            if (user == currentUser) {
+                return;
+            }
+            std::string game_name = channel.empty() ? team_a + "_" + team_b : channel;
+            eventStore.addRaw(game_name, user, frameStr.data() + range.first, range.second - range.first);
+            // One write, since workers print concurrently
+            std::cout << ("Received message from " + user + " in channel " + game_name + "\n") << std::flush;
+        }
+    } else {
+        std::string body = Frame::parse(frameStr).getBody();
+        std::vector<std::pair<size_t, size_t>> events = batched ? splitEventBatch(body, 0)
+            : std::vector<std::pair<size_t, size_t>>(1, std::make_pair(static_cast<size_t>(0), body.size()));
+        for (const auto& range : events) {
+            std::string eventBody = body.substr(range.first, range.second - range.first);
+            Event event(eventBody);
             
             std::string user = "";
-            std::stringstream bodyStream(body);
+            std::stringstream bodyStream(eventBody);
             std::string line;
             while (std::getline(bodyStream, line)) {
                 if (line.find("user: ") == 0) {
@@ -184,32 +485,16 @@ bool StompProtocol::handleServerFrame(const std::string& frameStr) {
                 }
             }
             
-            std::string currentUser;
-            {
-                std::lock_guard<std::mutex> lock(mtx);
-                currentUser = currentUserName;
-            }
-            
             if (user == currentUser) {
-                return true;
-            }
-            
-            std::string game_name = event.get_team_a_name() + "_" + event.get_team_b_name();
-            
-            {
-                std::lock_guard<std::mutex> lock(mtx);
-                gameEvents[game_name][user].push_back(event);
+                return;
             }
             
-            std::cout << "Received message from " << user << " in channel " << game_name << std::endl;
-            break;
+            std::string game_name = channel.empty() ? event.get_team_a_name() + "_" + event.get_team_b_name() : channel;
+            eventStore.add(game_name, user, event);
+            // One write, since workers print concurrently
+            std::cout << ("Received message from " + user + " in channel " + game_name + "\n") << std::flush;
         }
-            
-        case ServerCommand::UNKNOWN:
-            break;
     }
-    
-    return true;
 }
 
 // ============================================
@@ -217,18 +502,20 @@ bool StompProtocol::handleServerFrame(const std::string& frameStr) {
 // ============================================
 
 void StompProtocol::handleLogin(const std::vector<std::string>& args) {
-    {
-        std::lock_guard<std::mutex> lock(mtx);
-        if (isConnected) {
-            std::cout << "The client is already logged in, log out before trying again" << std::endl;
-            return;
-        }
+    if (isClientConnected()) {
+        std::cout << "The client is already logged in, log out before trying again" << std::endl;
+        return;
+    }
+    if (isConnectPending()) {
+        std::cout << "Login already in progress" << std::endl;
+        return;
     }
     
-    if (args.size() < 4) {
-        std::cout << "Usage: login {host:port} {username} {password}" << std::endl;
+    if (args.size() < 4 || (args.size() > 4 && args[4] != "--restore")) {
+        std::cout << "Usage: login {host:port} {username} {password} [--restore]" << std::endl;
         return;
     }
+    bool restore = args.size() > 4;
     
     std::string hostPort = args[1];
     std::string host = "127.0.0.1";
@@ -243,86 +530,274 @@ void StompProtocol::handleLogin(const std::vector<std::string>& args) {
     std::string password = args[3];
     
     {
-        std::lock_guard<std::mutex> lock(mtx);
+        std::random_device random;
+        std::ostringstream marker;
+        marker << std::hex << random() << random();
+        std::lock_guard<std::mutex> lock(stateMtx);
         currentUserName = username;
+        sessionMarker = marker.str();
     }
+    sendWindow.reset();
     
     Frame frame("CONNECT");
     frame.addHeader("accept-version", "1.2");
     frame.addHeader("host", host);
     frame.addHeader("login", username);
     frame.addHeader("passcode", password);
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        if (heartBeatSendMs != 0 || heartBeatReceiveMs != 0) {
+            frame.addHeader("heart-beat", std::to_string(heartBeatSendMs) + "," + std::to_string(heartBeatReceiveMs));
+        }
+    }
     
-    handler->sendFrameAscii(frame.toString(), '\0');
+    // Until CONNECTED, subscriptions are pending: committed by it, rolled back by an ERROR
+    {
+        std::lock_guard<std::mutex> lock(subscriptionMtx);
+        connectPending = true;
+    }
+    std::vector<Frame> frames;
+    frames.push_back(frame);
+    if (restore) {
+        // Pipelined behind the CONNECT: the server handles them once it has logged us in
+        std::vector<std::string> saved = savedSubscriptions.load(username);
+        if (saved.empty()) {
+            std::cout << "No saved subscriptions for " << username << std::endl;
+        }
+        subscribe(saved, "Restored", frames);
+    }
+    sendFrames(frames);
 }
 
-void StompProtocol::handleJoin(const std::vector<std::string>& args) {
-    if (args.size() < 2) {
-        std::cout << "Usage: join {game_name}" << std::endl;
+void StompProtocol::startHeartBeat(const std::string& serverHeader) {
+    uint64_t cx;
+    uint64_t cy;
+    {
+        std::lock_guard<std::mutex> lock(stateMtx);
+        cx = heartBeatSendMs;
+        cy = heartBeatReceiveMs;
+    }
+    // No header means the server does no heart-beating
+    uint64_t sx = 0;
+    uint64_t sy = 0;
+    if (!serverHeader.empty() && !HeartBeat::parse(serverHeader, sx, sy)) {
+        std::cout << "Ignoring malformed heart-beat header: " << serverHeader << std::endl;
+    }
+    uint64_t sendMs;
+    uint64_t expectMs;
+    HeartBeat::negotiate(cx, cy, sx, sy, sendMs, expectMs);
+    if (sendMs == 0 && expectMs == 0) {
         return;
     }
-    
-    std::string game_name = args[1];
-    
-    int sub_id, receipt_id;
+    // The callbacks run on the timer wheel and must never wait on the socket or on a
+    // sender. They use this session's handler, which setConnectionHandler() stops them
+    // before replacing.
+    ConnectionHandler* connection;
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        
-        if (subscriptions.count(game_name)) {
-            std::cout << "Already subscribed to " << game_name << std::endl;
-            return;
+        std::lock_guard<std::mutex> lock(sendMtx);
+        connection = handler;
+    }
+    if (connection == nullptr) {
+        return;
+    }
+    heartBeat.start(sendMs, expectMs,
+        [connection]() { return connection->lastWriteAt(); },
+        [connection]() { return connection->lastReadAt(); },
+        [this, connection]() {
+            // A frame being written is traffic enough
+            std::unique_lock<std::mutex> lock(sendMtx, std::try_to_lock);
+            return lock.owns_lock() && connection->sendByteNow('\n');
+        },
+        [connection, expectMs]() {
+            std::cout << "No heart-beat from the server for " << 2 * expectMs << "ms, disconnecting" << std::endl;
+            // Also wakes a write stuck on the silent peer; the socket thread then sees the
+            // connection end and closes the session
+            connection->shutdown();
+        });
+}
+
+void StompProtocol::subscribe(const std::vector<std::string>& game_names, const std::string& verb,
+                              std::vector<Frame>& frames, AckMode ackMode) {
+    std::vector<std::pair<std::string, int>> joined;
+    {
+        std::lock_guard<std::mutex> lock(subscriptionMtx);
+        for (const std::string& game_name : game_names) {
+            if (!subscriptions.emplace(game_name, subscriptionIdCounter).second) {
+                std::cout << "Already subscribed to " << game_name << std::endl;
+                continue;
+            }
+            joined.emplace_back(game_name, subscriptionIdCounter++);
+            if (connectPending) {
+                pendingSubscriptions.push_back(game_name);
+            }
         }
-        
-        sub_id = subscriptionIdCounter++;
+    }
+    if (joined.empty()) {
+        return;
+    }
+    for (const auto& sub : joined) {
+        std::string destination = "/" + sub.first;
+        subscriptionMonitor.track(sub.second, destination, inbound.channel(destination));
+        acks.track(sub.second, ackMode);
+    }
+    
+    // Frames are handled in order, so a receipt on the last one covers them all
+    int receipt_id;
+    {
+        std::lock_guard<std::mutex> lock(receiptMtx);
         receipt_id = receiptIdCounter++;
-        
-        subscriptions[game_name] = sub_id;
-        receiptActions[receipt_id] = "Joined channel " + game_name;
+        receiptActions[receipt_id] = joined.size() == 1 ? verb + " channel " + joined[0].first
+                                                         : verb + " " + std::to_string(joined.size()) + " channels";
     }
     
-    Frame frame("SUBSCRIBE");
-    frame.addHeader("destination", "/" + game_name);
-    frame.addHeader("id", std::to_string(sub_id));
-    frame.addHeader("receipt", std::to_string(receipt_id));
+    for (const auto& sub : joined) {
+        Frame frame("SUBSCRIBE");
+        frame.addHeader("destination", "/" + sub.first);
+        frame.addHeader("id", std::to_string(sub.second));
+        if (ackMode != AckMode::AUTO) {
+            frame.addHeader("ack", AckBatcher::modeName(ackMode));
+        }
+        frames.push_back(frame);
+    }
+    frames.back().addHeader("receipt", std::to_string(receipt_id));
+}
+
+void StompProtocol::handleJoin(const std::vector<std::string>& args) {
+    AckMode ackMode = AckMode::AUTO;
+    size_t first = 1;
+    if (args.size() > 2 && args[1] == "--ack") {
+        if (!AckBatcher::parseMode(args[2], ackMode)) {
+            std::cout << "Unknown ack mode: " << args[2] << std::endl;
+            return;
+        }
+        first = 3;
+    }
+    if (args.size() <= first) {
+        std::cout << "Usage: join [--ack auto|client|client-individual] {game_name} [game_name ...]" << std::endl;
+        return;
+    }
     
-    handler->sendFrameAscii(frame.toString(), '\0');
+    std::vector<Frame> frames;
+    subscribe(std::vector<std::string>(args.begin() + first, args.end()), "Joined", frames, ackMode);
+    if (frames.empty()) {
+        return;
+    }
+    sendFrames(frames);
+    saveSubscriptions();
 }
 
 void StompProtocol::handleExit(const std::vector<std::string>& args) {
     if (args.size() < 2) {
-        std::cout << "Usage: exit {game_name}" << std::endl;
+        std::cout << "Usage: exit {game_name} [game_name ...]" << std::endl;
         return;
     }
     
-    std::string game_name = args[1];
-    
-    int sub_id, receipt_id;
+    std::vector<std::pair<std::string, int>> exited;
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        
-        if (subscriptions.find(game_name) == subscriptions.end()) {
-            std::cout << "Error: Not subscribed to " << game_name << std::endl;
-            return;
+        std::lock_guard<std::mutex> lock(subscriptionMtx);
+        for (size_t i = 1; i < args.size(); i++) {
+            const std::string& game_name = args[i];
+            auto it = subscriptions.find(game_name);
+            if (it == subscriptions.end()) {
+                std::cout << "Error: Not subscribed to " << game_name << std::endl;
+                continue;
+            }
+            exited.emplace_back(game_name, it->second);
+            subscriptions.erase(it);
+            auto pending = std::find(pendingSubscriptions.begin(), pendingSubscriptions.end(), game_name);
+            if (pending != pendingSubscriptions.end()) {
+                pendingSubscriptions.erase(pending);
+            }
         }
-        
-        sub_id = subscriptions[game_name];
+    }
+    if (exited.empty()) {
+        return;
+    }
+    for (const auto& sub : exited) {
+        subscriptionMonitor.untrack(sub.second);
+    }
+    
+    int receipt_id;
+    {
+        std::lock_guard<std::mutex> lock(receiptMtx);
         receipt_id = receiptIdCounter++;
-        
-        receiptActions[receipt_id] = "Exited channel " + game_name;
-        subscriptions.erase(game_name);
+        receiptActions[receipt_id] = exited.size() == 1 ? "Exited channel " + exited[0].first
+                                                        : "Exited " + std::to_string(exited.size()) + " channels";
     }
     
-    Frame frame("UNSUBSCRIBE");
-    frame.addHeader("id", std::to_string(sub_id));
-    frame.addHeader("receipt", std::to_string(receipt_id));
+    std::vector<Frame> frames;
+    frames.reserve(exited.size());
+    for (const auto& sub : exited) {
+        Frame frame("UNSUBSCRIBE");
+        frame.addHeader("id", std::to_string(sub.second));
+        frames.push_back(frame);
+    }
+    frames.back().addHeader("receipt", std::to_string(receipt_id));
     
-    handler->sendFrameAscii(frame.toString(), '\0');
+    // The ACKs still waiting for these subscriptions go out ahead of the UNSUBSCRIBEs
+    sendFrames(frames);
+    for (const auto& sub : exited) {
+        acks.untrack(sub.second);
+    }
+    saveSubscriptions();
+}
+
+void StompProtocol::saveSubscriptions() {
+    std::string user = getCurrentUserName();
+    std::lock_guard<std::mutex> lock(subscriptionMtx);
+    if (connectPending) {
+        return;   // saved once CONNECTED confirms them
+    }
+    std::vector<std::pair<int, std::string>> byId;
+    byId.reserve(subscriptions.size());
+    for (const auto& kv : subscriptions) {
+        byId.emplace_back(kv.second, kv.first);
+    }
+    std::sort(byId.begin(), byId.end());
+    std::vector<std::string> channels;
+    channels.reserve(byId.size());
+    for (const auto& sub : byId) {
+        channels.push_back(sub.second);
+    }
+    savedSubscriptions.save(user, channels);
+}
+
+void StompProtocol::settlePendingSubscriptions(bool connected) {
+    std::vector<int> rolledBack;
+    {
+        std::lock_guard<std::mutex> lock(subscriptionMtx);
+        if (!connectPending) {
+            return;
+        }
+        connectPending = false;
+        if (!connected) {
+            for (const std::string& game_name : pendingSubscriptions) {
+                auto it = subscriptions.find(game_name);
+                if (it != subscriptions.end()) {
+                    rolledBack.push_back(it->second);
+                    subscriptions.erase(it);
+                }
+            }
+        }
+        pendingSubscriptions.clear();
+    }
+    if (connected) {
+        saveSubscriptions();
+        return;
+    }
+    for (int id : rolledBack) {
+        subscriptionMonitor.untrack(id);
+        acks.untrack(id);
+    }
+    if (!rolledBack.empty()) {
+        std::cout << "Rolled back " << rolledBack.size() << " subscriptions sent with the login" << std::endl;
+    }
 }
 
 void StompProtocol::handleLogout() {
     int receipt_id;
     {
-        std::lock_guard<std::mutex> lock(mtx);
+        std::lock_guard<std::mutex> lock(receiptMtx);
         receipt_id = receiptIdCounter++;
         receiptActions[receipt_id] = "DISCONNECT";
     }
@@ -330,154 +805,573 @@ void StompProtocol::handleLogout() {
     Frame frame("DISCONNECT");
     frame.addHeader("receipt", std::to_string(receipt_id));
     
-    handler->sendFrameAscii(frame.toString(), '\0');
+    sendFrame(frame);
 }
 
 void StompProtocol::handleReport(const std::vector<std::string>& args) {
-    if (args.size() < 2) {
-        std::cout << "Usage: report {file_path}" << std::endl;
+    std::string file_path;
+    double pace = 0;
+    bool follow = false;
+    bool unfollow = false;
+    bool resume = false;
+    long batch = 1;
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "--pace" && i + 1 < args.size()) {
+            try {
+                pace = std::stod(args[++i]);
+            } catch (const std::exception& e) {
+                pace = -1;
+            }
+        } else if (args[i] == "--batch" && i + 1 < args.size()) {
+            try {
+                batch = std::stol(args[++i]);
+            } catch (const std::exception& e) {
+                batch = 0;
+            }
+        } else if (args[i] == "--follow") {
+            follow = true;
+        } else if (args[i] == "--unfollow") {
+            unfollow = true;
+        } else if (args[i] == "--resume") {
+            resume = true;
+        } else {
+            file_path = args[i];
+        }
+    }
+    
+    // Paced and followed events go out one at a time, as they become due
+    if (file_path.empty() || pace < 0 || batch < 1 || (batch > 1 && (pace > 0 || follow || unfollow))) {
+        std::cout << "Usage: report [--pace {speed} | --resume | --follow | --unfollow] [--batch {events}] {file_path}"
+                  << std::endl;
         return;
     }
     
-    std::string file_path = args[1];
+    if (follow) {
+        std::string error;
+        if (reportFollower.follow(file_path, error)) {
+            std::cout << "Following " << file_path << std::endl;
+        } else {
+            std::cout << "Error: cannot follow " << file_path << ": " << error << std::endl;
+        }
+        return;
+    }
     
-    names_and_events names_events;
-    try {
-        names_events = parseEventsFile(file_path);
-    } catch (const std::exception& e) {
-        std::cout << "Error reading file: " << e.what() << std::endl;
+    if (unfollow) {
+        if (reportFollower.unfollow(file_path)) {
+            std::cout << "Stopped following " << file_path << std::endl;
+        } else {
+            std::cout << "Error: not following " << file_path << std::endl;
+        }
+        return;
+    }
+    
+    CachedReport report;
+    ReportKey key;
+    if (!loadReport(file_path, report, key)) {
         return;
     }
     
-    std::string game_name = names_events.team_a_name + "_" + names_events.team_b_name;
+    std::string game_name = report.team_a_name + "_" + report.team_b_name;
     
+    if (!isSubscribed(game_name)) {
+        std::cout << "Error: not subscribed to " << game_name << std::endl;
+        return;
+    }
+    
+    std::string user;
+    size_t interval;
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        if (subscriptions.find(game_name) == subscriptions.end()) {
-            std::cout << "Error: not subscribed to " << game_name << std::endl;
-            return;
-        }
+        std::lock_guard<std::mutex> lock(stateMtx);
+        user = currentUserName;
+        interval = checkpointInterval;
     }
+    std::string userLine = "user: " + user + "\n";
     
-    for (const Event& event : names_events.events) {
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-            gameEvents[game_name][currentUserName].push_back(event);
+    if (pace > 0) {
+        schedulePacedReport(game_name, userLine, report, pace);
+        return;
+    }
+    
+    size_t first = 0;
+    if (resume) {
+        first = std::min(reportCheckpoints.acknowledged(key.path, key.hash), report.bodies.size());
+        std::cout << "Resuming " << file_path << " from event " << first << " of " << report.bodies.size() << std::endl;
+    }
+    
+    // Up to batch events per SEND, so headers, framing and the broker's per-frame work
+    // are paid once per batch
+    size_t perFrame = static_cast<size_t>(batch);
+    for (size_t i = first; i < report.bodies.size(); i += perFrame) {
+        // Blocks while the flow-control window is full
+        bool windowReceipt = false;
+        if (!sendWindow.acquire(windowReceipt)) {
+            std::cout << "Report interrupted after " << i << " events: disconnected" << std::endl;
+            return;
         }
         
+        size_t end = std::min(i + perFrame, report.bodies.size());
         std::string body;
-        body += "user: " + currentUserName + "\n";
-        body += "team a: " + names_events.team_a_name + "\n";
-        body += "team b: " + names_events.team_b_name + "\n";
-        body += "event name: " + event.get_name() + "\n";
-        body += "time: " + std::to_string(event.get_time()) + "\n";
-        
-        body += "general game updates:\n";
-        for (const auto& kv : event.get_game_updates()) {
-            body += kv.first + ":" + kv.second + "\n";
-        }
-        
-        body += "team a updates:\n";
-        for (const auto& kv : event.get_team_a_updates()) {
-            body += kv.first + ":" + kv.second + "\n";
+        for (size_t j = i; j < end; j++) {
+            std::string eventBody = userLine + report.bodies[j];
+            eventStore.add(game_name, user, Event(eventBody));
+            if (j > i) {
+                body += EVENT_SEPARATOR;
+            }
+            body += eventBody;
         }
         
-        body += "team b updates:\n";
-        for (const auto& kv : event.get_team_b_updates()) {
-            body += kv.first + ":" + kv.second + "\n";
+        Frame frame = buildSendFrame(game_name, body);
+        if (end - i > 1) {
+            frame.addHeader("event-count", std::to_string(end - i));
         }
         
-        body += "description:\n" + event.get_discription() + "\n";
+        // Each frame reaching the next multiple of N events, and the last one, asks for a
+        // receipt that advances the checkpoint
+        bool last = end == report.bodies.size();
+        bool checkpoint = interval > 0 && (end / interval > i / interval || last);
         
-        Frame frame("SEND");
-        frame.addHeader("destination", "/" + game_name);
-        frame.setBody(body);
+        if (checkpoint || windowReceipt) {
+            int receipt_id;
+            {
+                std::lock_guard<std::mutex> lock(receiptMtx);
+                receipt_id = receiptIdCounter++;
+                reportReceipts[receipt_id] = ReportReceipt(key.path, key.hash, end, checkpoint);
+            }
+            frame.addHeader("receipt", std::to_string(receipt_id));
+            if (windowReceipt) {
+                sendWindow.track(receipt_id);
+            }
+        }
         
-        handler->sendFrameAscii(frame.toString(), '\0');
+        sendFrame(frame);
     }
 }
 
-void StompProtocol::handleSummary(const std::vector<std::string>& args) {
-    if (args.size() < 4) {
-        std::cout << "Usage: summary {game_name} {user_name} {file_path}" << std::endl;
+void StompProtocol::schedulePacedReport(const std::string& game_name, const std::string& userLine,
+                                        const CachedReport& report, double speed) {
+    if (report.bodies.empty()) {
         return;
     }
     
-    std::string game_name = args[1];
-    std::string user_name = args[2];
-    std::string file_path = args[3];
-    
-    // Copy events while holding lock to prevent iterator invalidation
     std::vector<Event> events;
-    {
-        std::lock_guard<std::mutex> lock(mtx);
-        
-        if (gameEvents.find(game_name) == gameEvents.end()) {
-            std::cout << "No events found for game: " << game_name << std::endl;
-            return;
-        }
-        if (gameEvents[game_name].find(user_name) == gameEvents[game_name].end()) {
-            std::cout << "No events found for user: " << user_name << " in game " << game_name << std::endl;
-            return;
-        }
+    events.reserve(report.bodies.size());
+    int firstTime = 0;
+    int lastTime = 0;
+    for (const std::string& eventBody : report.bodies) {
+        events.push_back(Event(userLine + eventBody));
+        int t = events.back().get_time();
+        if (events.size() == 1 || t < firstTime) firstTime = t;
+        if (events.size() == 1 || t > lastTime) lastTime = t;
+    }
+    
+    std::shared_ptr<std::atomic<size_t>> remaining = std::make_shared<std::atomic<size_t>>(events.size());
+    // This report's own skew, printed when it finishes; paceSkew keeps every report's for stats
+    std::shared_ptr<Histogram> skewOfReport = std::make_shared<Histogram>();
+    TimerWheel::Clock::time_point start = TimerWheel::Clock::now();
+    
+    for (size_t i = 0; i < events.size(); i++) {
+        std::chrono::duration<double> offset((events[i].get_time() - firstTime) / speed);
+        TimerWheel::Clock::time_point due = start + std::chrono::duration_cast<TimerWheel::Clock::duration>(offset);
+        std::string body = userLine + report.bodies[i];
+        Event event = events[i];
         
-        events = gameEvents[game_name][user_name];
+        paceTimers.schedule(due, [this, game_name, body, event, due, remaining, skewOfReport]() {
+            TimerWheel::Clock::duration skew = TimerWheel::Clock::now() - due;
+            uint64_t skewUs = static_cast<uint64_t>(std::max<long long>(0,
+                std::chrono::duration_cast<std::chrono::microseconds>(skew).count()));
+            paceSkew.record(skewUs);
+            skewOfReport->record(skewUs);
+            
+            if (isClientConnected()) {
+                eventStore.add(game_name, getCurrentUserName(), event);
+                
+                sendFrame(buildSendFrame(game_name, body));
+            }
+            
+            if (--(*remaining) == 0) {
+                std::cout << "Paced report to " << game_name << " finished" << std::endl;
+                skewOfReport->print(std::cout, "Pace skew", "us");
+            }
+        });
     }
     
-    std::map<std::string, std::string> general_stats;
-    std::map<std::string, std::string> team_a_stats;
-    std::map<std::string, std::string> team_b_stats;
+    std::cout << "Pacing " << events.size() << " events to " << game_name << " over "
+              << (lastTime - firstTime) / speed << "s" << std::endl;
+}
+
+void StompProtocol::handleFollowedEvent(const std::string& team_a, const std::string& team_b, const Event& event) {
+    std::string game_name = team_a + "_" + team_b;
+    
+    if (!isClientConnected() || !isSubscribed(game_name)) {
+        std::cout << "Error: not subscribed to " << game_name << std::endl;
+        return;
+    }
+    std::string user = getCurrentUserName();
+    std::string userLine = "user: " + user + "\n";
+    eventStore.add(game_name, user, event);
     
-    for (const Event& ev : events) {
-        for (const auto& kv : ev.get_game_updates()) {
-            general_stats[kv.first] = kv.second;
-        }
-        for (const auto& kv : ev.get_team_a_updates()) {
-            team_a_stats[kv.first] = kv.second;
-        }
-        for (const auto& kv : ev.get_team_b_updates()) {
-            team_b_stats[kv.first] = kv.second;
+    sendFrame(buildSendFrame(game_name, userLine + buildEventBody(event, team_a, team_b)));
+}
+
+bool StompProtocol::loadReport(const std::string& file_path, CachedReport& report, ReportKey& key) {
+    key = ReportKey{file_path, 0, 0, 0};
+    bool keyed = ReportCache::makeKey(file_path, key);
+    if (keyed && reportCache.lookup(key, report)) {
+        return true;
+    }
+    
+    names_and_events names_events;
+    try {
+        names_events = parseEventsFile(file_path);
+    } catch (const std::exception& e) {
+        std::cout << "Error reading file: " << e.what() << std::endl;
+        return false;
+    }
+    
+    report.team_a_name = names_events.team_a_name;
+    report.team_b_name = names_events.team_b_name;
+    report.bodies.clear();
+    report.bodies.reserve(names_events.events.size());
+    for (const Event& event : names_events.events) {
+        report.bodies.push_back(buildEventBody(event, names_events.team_a_name, names_events.team_b_name));
+    }
+    
+    if (keyed) {
+        reportCache.store(key, report);
+    }
+    return true;
+}
+
+std::string StompProtocol::buildEventBody(const Event& event, const std::string& team_a, const std::string& team_b) {
+    std::string body;
+    body += "team a: " + team_a + "\n";
+    body += "team b: " + team_b + "\n";
+    body += "event name: " + event.get_name() + "\n";
+    body += "time: " + std::to_string(event.get_time()) + "\n";
+    
+    body += "general game updates:\n";
+    for (const auto& kv : event.get_game_updates()) {
+        body += kv.first + ":" + kv.second + "\n";
+    }
+    
+    body += "team a updates:\n";
+    for (const auto& kv : event.get_team_a_updates()) {
+        body += kv.first + ":" + kv.second + "\n";
+    }
+    
+    body += "team b updates:\n";
+    for (const auto& kv : event.get_team_b_updates()) {
+        body += kv.first + ":" + kv.second + "\n";
+    }
+    
+    body += "description:\n" + event.get_discription() + "\n";
+    return body;
+}
+
+void StompProtocol::handleSummary(const std::vector<std::string>& args) {
+    std::vector<std::string> positional;
+    bool at = false;
+    int atTime = 0;
+    for (size_t i = 1; i < args.size(); i++) {
+        if (args[i] == "--at" && i + 1 < args.size()) {
+            try {
+                atTime = std::stoi(args[++i]);
+                at = true;
+            } catch (const std::exception& e) {
+                positional.clear();
+                break;
+            }
+        } else {
+            positional.push_back(args[i]);
         }
     }
     
+    if (positional.size() != 3) {
+        std::cout << "Usage: summary {game_name} {user_name|*} {file_path} [--at {seconds}]" << std::endl;
+        return;
+    }
+    
+    std::string game_name = positional[0];
+    std::string user_name = positional[1];
+    std::string file_path = positional[2];
+    
+    if (user_name == "*") {
+        summarizeAllUsers(game_name, at ? atTime : std::numeric_limits<int>::max(), file_path);
+        return;
+    }
+    
+    // Rendered from a snapshot of the game, so a slow file write holds up no fold
+    std::string summary;
+    bool found = false;
+    bool knownGame = eventStore.read(game_name, [&](const GameEventStore& store) {
+        found = at ? store.summarizeAt(game_name, user_name, atTime, summary)
+                   : store.summarize(game_name, user_name, summary);
+    });
+    if (!knownGame) {
+        std::cout << "No events found for game: " << game_name << std::endl;
+        return;
+    }
+    if (!found) {
+        std::cout << "No events found for user: " << user_name << " in game " << game_name << std::endl;
+        return;
+    }
+    
     std::ofstream outfile(file_path);
     if (!outfile.is_open()) {
         std::cout << "Error: Cannot write to file: " << file_path << std::endl;
         return;
     }
     
-    if (!events.empty()) {
-        outfile << events[0].get_team_a_name() << " vs " << events[0].get_team_b_name() << "\n";
-        outfile << "Game stats:\n";
-        
-        outfile << "General stats:\n";
-        for (const auto& kv : general_stats) {
-            outfile << kv.first << ": " << kv.second << "\n";
+    outfile << summary;
+    outfile.close();
+    std::cout << "Summary written to " << file_path << std::endl;
+}
+
+void StompProtocol::summarizeAllUsers(const std::string& game_name, int time, const std::string& file_path) {
+    std::ofstream outfile(file_path);
+    if (!outfile.is_open()) {
+        std::cout << "Error: Cannot write to file: " << file_path << std::endl;
+        return;
+    }
+    
+    // The merge streams into the file, so there is no combined copy to build first
+    size_t duplicates = 0;
+    bool knownGame = eventStore.read(game_name, [&](const GameEventStore& store) {
+        store.summarizeMerged(game_name, time, outfile, duplicates);
+    });
+    if (!knownGame) {
+        std::cout << "No events found for game: " << game_name << std::endl;
+        return;
+    }
+    
+    outfile.close();
+    std::cout << "Summary written to " << file_path;
+    if (duplicates > 0) {
+        std::cout << " (" << duplicates << " duplicate reports collapsed)";
+    }
+    std::cout << std::endl;
+}
+
+void StompProtocol::handleQuery(const std::vector<std::string>& args) {
+    EventQuery q;
+    std::string file_path;
+    std::vector<std::string> positional;
+    bool valid = true;
+    
+    for (size_t i = 1; i < args.size() && valid; i++) {
+        const std::string& arg = args[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            positional.push_back(arg);
+            continue;
         }
-        
-        outfile << events[0].get_team_a_name() << " stats:\n";
-        for (const auto& kv : team_a_stats) {
-            outfile << kv.first << ": " << kv.second << "\n";
+        // Event names and stat keys may contain spaces: a value runs up to the next flag
+        std::string value;
+        while (i + 1 < args.size() && args[i + 1].compare(0, 2, "--") != 0) {
+            value += (value.empty() ? "" : " ") + args[++i];
         }
-        
-        outfile << events[0].get_team_b_name() << " stats:\n";
-        for (const auto& kv : team_b_stats) {
-            outfile << kv.first << ": " << kv.second << "\n";
+        try {
+            if (arg == "--from" && !value.empty()) {
+                q.from = std::stoi(value);
+            } else if (arg == "--to" && !value.empty()) {
+                q.to = std::stoi(value);
+            } else if (arg == "--event" && !value.empty()) {
+                q.eventName = value;
+            } else if (arg == "--stat" && !value.empty()) {
+                q.statKey = value;
+            } else if (arg == "--out" && !value.empty()) {
+                file_path = value;
+            } else {
+                valid = false;
+            }
+        } catch (const std::exception& e) {
+            valid = false;
         }
-        
-        // Sort events chronologically by time before printing
-        std::sort(events.begin(), events.end(), 
-            [](const Event& a, const Event& b) { 
-                return a.get_time() < b.get_time(); 
-            });
-        
-        outfile << "Game event reports:\n";
-        for (const Event& ev : events) {
-            outfile << ev.get_time() << " - " << ev.get_name() << ":\n\n";
-            outfile << ev.get_discription() << "\n\n\n";
+    }
+    
+    if (!valid || positional.empty() || positional.size() > 2) {
+        std::cout << "Usage: query {game_name} [user_name] [--from {seconds}] [--to {seconds}] "
+                  << "[--event {name}] [--stat {key}] [--out {file_path}]" << std::endl;
+        return;
+    }
+    q.game = positional[0];
+    if (positional.size() == 2) {
+        q.user = positional[1];
+    }
+    
+    // Only the matching events are rendered
+    std::string result;
+    size_t matches = 0;
+    bool found = false;
+    bool knownGame = eventStore.read(q.game, [&](const GameEventStore& store) {
+        found = store.query(q, result, matches);
+    });
+    if (!knownGame) {
+        std::cout << "No events found for game: " << q.game << std::endl;
+        return;
+    }
+    if (!found) {
+        std::cout << "No events found for user: " << q.user << " in game " << q.game << std::endl;
+        return;
+    }
+    
+    if (file_path.empty()) {
+        std::cout << result << matches << " matching events" << std::endl;
+        return;
+    }
+    
+    std::ofstream outfile(file_path);
+    if (!outfile.is_open()) {
+        std::cout << "Error: Cannot write to file: " << file_path << std::endl;
+        return;
+    }
+    outfile << result;
+    outfile.close();
+    std::cout << matches << " matching events written to " << file_path << std::endl;
+}
+
+void StompProtocol::handleSearch(const std::vector<std::string>& args) {
+    std::vector<std::string> words;
+    bool any = false;
+    for (size_t i = 2; i < args.size(); i++) {
+        if (args[i] == "--or") {
+            any = true;
+        } else if (!args[i].empty()) {
+            words.push_back(args[i]);
         }
     }
     
+    if (args.size() < 3 || words.empty()) {
+        std::cout << "Usage: search {game_name|*} [--or] {terms...}" << std::endl;
+        return;
+    }
+    
+    std::string result;
+    size_t matches = 0;
+    auto start = std::chrono::steady_clock::now();
+    if (args[1] == "*") {
+        eventStore.readAll([&](const std::string& game_name, const GameEventStore& store) {
+            std::string part;
+            size_t partMatches = 0;
+            store.search(game_name, words, any, part, partMatches);
+            result += part;
+            matches += partMatches;
+        });
+    } else if (!eventStore.read(args[1], [&](const GameEventStore& store) {
+                   store.search(args[1], words, any, result, matches);
+               })) {
+        std::cout << "No events found for game: " << args[1] << std::endl;
+        return;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << result << matches << " matching events (" << ms << " ms)" << std::endl;
+}
+
+void StompProtocol::handleLatency(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        echoLatency.print(std::cout);
+        return;
+    }
+    
+    std::ofstream outfile(args[1]);
+    if (!outfile.is_open()) {
+        std::cout << "Error: Cannot write to file: " << args[1] << std::endl;
+        return;
+    }
+    echoLatency.print(outfile);
     outfile.close();
-    std::cout << "Summary written to " << file_path << std::endl;
+    std::cout << "Latency written to " << args[1] << std::endl;
+}
+
+void StompProtocol::handleConfig(const std::vector<std::string>& args) {
+    if (args.size() < 3) {
+        std::cout << "Usage: config {option} {value}" << std::endl;
+        return;
+    }
+    
+    const std::string& option = args[1];
+    const std::string& value = args[2];
+    
+    try {
+        if (option == "report-cache-budget") {
+            reportCache.setMemoryBudget(std::stoul(value));
+        } else if (option == "report-cache-spill") {
+            reportCache.setSpillDirectory(value == "off" ? "" : value);
+        } else if (option == "report-checkpoint-interval") {
+            size_t interval = std::stoul(value);
+            std::lock_guard<std::mutex> lock(stateMtx);
+            checkpointInterval = interval;
+        } else if (option == "report-checkpoint-file") {
+            reportCheckpoints.setPath(value);
+        } else if (option == "subscription-file") {
+            savedSubscriptions.setPath(value);
+        } else if (option == "summary-checkpoint-interval") {
+            eventStore.setCheckpointInterval(std::stoul(value));
+        } else if (option == "decode") {
+            if (value != "lazy" && value != "eager") {
+                throw std::invalid_argument(value);
+            }
+            std::lock_guard<std::mutex> lock(stateMtx);
+            lazyDecoding = value == "lazy";
+        } else if (option == "kernel-timestamps") {
+            if (value != "on" && value != "off") {
+                throw std::invalid_argument(value);
+            }
+            std::lock_guard<std::mutex> lock(stateMtx);
+            kernelTimestamps = value == "on";
+        } else if (option == "heart-beat") {
+            uint64_t sendMs = 0;
+            uint64_t receiveMs = 0;
+            if (value != "off" && !HeartBeat::parse(value, sendMs, receiveMs)) {
+                throw std::invalid_argument(value);
+            }
+            std::lock_guard<std::mutex> lock(stateMtx);
+            heartBeatSendMs = sendMs;
+            heartBeatReceiveMs = receiveMs;
+        } else if (option == "ack-batch") {
+            acks.setBatchSize(std::stoul(value));
+        } else if (option == "ack-interval") {
+            acks.setInterval(std::chrono::milliseconds(std::stoul(value)));
+        } else if (option == "compress") {
+            if (value != "off" && value != FrameCompression::ENCODING) {
+                throw std::invalid_argument(value);
+            }
+            compression.setEnabled(value != "off");
+        } else if (option == "compress-threshold") {
+            compression.setThreshold(std::stoul(value));
+        } else if (option == "inbound-workers") {
+            inbound.setWorkers(std::stoul(value));
+        } else if (option == "inbound-rate") {
+            inbound.setRateLimit(value == "off" ? 0 : std::stod(value));
+        } else if (option == "inbound-queue-limit") {
+            inbound.setQueueLimit(value == "off" ? 0 : std::stoul(value));
+        } else if (option == "inbound-policy") {
+            inbound.setPolicy(value);
+        } else if (option == "send-window") {
+            sendWindow.setWindow(value == "off" ? 0 : std::stoul(value));
+        } else if (option == "send-window-receipt-every") {
+            sendWindow.setReceiptEvery(std::stoul(value));
+        } else {
+            std::cout << "Unknown option: " << option << std::endl;
+            return;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Invalid value for " << option << ": " << value << std::endl;
+        return;
+    }
+    
+    std::cout << option << " set to " << value << std::endl;
+}
+
+void StompProtocol::handleStats() {
+    eventStore.printStats(std::cout);
+    inbound.printStats(std::cout);
+    std::cout << "Self-echoes dropped unparsed: " << selfEchoesDropped << std::endl;
+    subscriptionMonitor.printStats(std::cout);
+    acks.printStats(std::cout);
+    compression.printStats(std::cout);
+    reportCache.printStats(std::cout);
+    paceSkew.print(std::cout, "Pace skew", "us");
+    sendWindow.printStats(std::cout);
+    heartBeat.printStats(std::cout);
 }
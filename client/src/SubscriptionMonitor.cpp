@@ -0,0 +1,171 @@
+#include "../include/SubscriptionMonitor.h"
+#include "../include/Frame.h"
+#include <chrono>
+#include <limits>
+
+SubscriptionMonitor::Slot::Slot() :
+    active(false), destination(), route(nullptr), messages(0), lastMessageId(0), reordered(0), duplicates(0),
+    expectedSequence(0), missing(0), handled(0), minDelay(std::numeric_limits<int64_t>::max()),
+    lastLag(0), maxLag(0)
+{
+}
+
+SubscriptionMonitor::SubscriptionMonitor() : chunks(), trackMtx()
+{
+    for (size_t i = 0; i < MAX_CHUNKS; i++) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SubscriptionMonitor::~SubscriptionMonitor() {
+    for (size_t i = 0; i < MAX_CHUNKS; i++) {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+SubscriptionMonitor::Slot* SubscriptionMonitor::slot(uint64_t id) const {
+    if (id >= CHUNK_SIZE * MAX_CHUNKS) {
+        return nullptr;
+    }
+    Slot* chunk = chunks[id / CHUNK_SIZE].load(std::memory_order_acquire);
+    return chunk == nullptr ? nullptr : &chunk[id % CHUNK_SIZE];
+}
+
+void SubscriptionMonitor::track(int id, const std::string& destination, InboundDispatcher::Channel* route) {
+    if (id < 0 || static_cast<uint64_t>(id) >= CHUNK_SIZE * MAX_CHUNKS) {
+        return;
+    }
+    size_t index = static_cast<size_t>(id) / CHUNK_SIZE;
+    {
+        std::lock_guard<std::mutex> lock(trackMtx);
+        if (chunks[index].load(std::memory_order_relaxed) == nullptr) {
+            chunks[index].store(new Slot[CHUNK_SIZE], std::memory_order_release);
+        }
+    }
+    Slot& s = *slot(static_cast<uint64_t>(id));
+    s.destination = destination;
+    s.route = route;
+    s.active.store(true, std::memory_order_release);
+}
+
+void SubscriptionMonitor::untrack(int id) {
+    Slot* s = id < 0 ? nullptr : slot(static_cast<uint64_t>(id));
+    if (s != nullptr) {
+        s->active.store(false, std::memory_order_release);
+    }
+}
+
+const std::string* SubscriptionMonitor::destination(uint64_t id) const {
+    const Slot* s = slot(id);
+    return s != nullptr && s->active.load(std::memory_order_acquire) ? &s->destination : nullptr;
+}
+
+InboundDispatcher::Channel* SubscriptionMonitor::route(uint64_t id) const {
+    const Slot* s = slot(id);
+    return s != nullptr && s->active.load(std::memory_order_acquire) ? s->route : nullptr;
+}
+
+void SubscriptionMonitor::onReceived(const std::string& frameStr) {
+    uint64_t id;
+    if (!Frame::peekNumber(frameStr, "subscription", id)) {
+        return;
+    }
+    Slot* s = slot(id);
+    if (s == nullptr || !s->active.load(std::memory_order_acquire)) {
+        return;
+    }
+    s->messages.store(s->messages.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // message-ids are global on the broker, so they only show order, not loss
+    uint64_t messageId;
+    if (Frame::peekNumber(frameStr, "message-id", messageId)) {
+        uint64_t last = s->lastMessageId.load(std::memory_order_relaxed);
+        if (messageId == last) {
+            s->duplicates.store(s->duplicates.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else if (messageId < last) {
+            s->reordered.store(s->reordered.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else {
+            s->lastMessageId.store(messageId, std::memory_order_relaxed);
+        }
+    }
+
+    // channel-seq counts every message on the channel, so a jump is a gap
+    uint64_t sequence;
+    if (Frame::peekNumber(frameStr, "channel-seq", sequence)) {
+        uint64_t expected = s->expectedSequence.load(std::memory_order_relaxed);
+        uint64_t missing = s->missing.load(std::memory_order_relaxed);
+        if (expected == 0 || sequence >= expected) {
+            // The first message only sets where the subscription joined the channel
+            if (expected != 0) {
+                s->missing.store(missing + (sequence - expected), std::memory_order_relaxed);
+            }
+            s->expectedSequence.store(sequence + 1, std::memory_order_relaxed);
+        } else if (missing > 0) {
+            s->missing.store(missing - 1, std::memory_order_relaxed);   // a late one counted missing
+        }
+    }
+}
+
+void SubscriptionMonitor::onHandled(const std::string& frameStr) {
+    uint64_t id;
+    uint64_t sentAt;
+    if (!Frame::peekNumber(frameStr, "subscription", id) || !Frame::peekNumber(frameStr, "send-ts", sentAt)) {
+        return;
+    }
+    Slot* s = slot(id);
+    if (s == nullptr || !s->active.load(std::memory_order_acquire)) {
+        return;
+    }
+    int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t delay = now - static_cast<int64_t>(sentAt);
+    int64_t minDelay = s->minDelay.load(std::memory_order_relaxed);
+    if (delay < minDelay) {
+        minDelay = delay;
+        s->minDelay.store(delay, std::memory_order_relaxed);
+    }
+    int64_t lag = delay - minDelay;
+    s->lastLag.store(lag, std::memory_order_relaxed);
+    if (lag > s->maxLag.load(std::memory_order_relaxed)) {
+        s->maxLag.store(lag, std::memory_order_relaxed);
+    }
+    s->handled.store(s->handled.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void SubscriptionMonitor::printStats(std::ostream& out) const {
+    size_t active = 0;
+    size_t idle = 0;
+    for (size_t c = 0; c < MAX_CHUNKS; c++) {
+        Slot* chunk = chunks[c].load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            continue;
+        }
+        for (size_t i = 0; i < CHUNK_SIZE; i++) {
+            const Slot& s = chunk[i];
+            if (!s.active.load(std::memory_order_acquire)) {
+                continue;
+            }
+            active++;
+            // Only the ones with traffic get a line, there may be tens of thousands
+            if (s.messages.load(std::memory_order_relaxed) == 0 && s.handled.load(std::memory_order_relaxed) == 0) {
+                idle++;
+                continue;
+            }
+            out << "Subscription " << c * CHUNK_SIZE + i << " (" << s.destination << "): "
+                << s.messages.load(std::memory_order_relaxed) << " received, "
+                << s.missing.load(std::memory_order_relaxed) << " missing, "
+                << s.reordered.load(std::memory_order_relaxed) << " reordered, "
+                << s.duplicates.load(std::memory_order_relaxed) << " duplicates";
+            if (s.handled.load(std::memory_order_relaxed) > 0) {
+                out << ", lag " << s.lastLag.load(std::memory_order_relaxed) / 1000.0 << " ms (max "
+                    << s.maxLag.load(std::memory_order_relaxed) / 1000.0 << " ms)";
+            }
+            out << std::endl;
+        }
+    }
+    if (active == 0) {
+        out << "No active subscriptions" << std::endl;
+    } else if (idle > 0) {
+        out << idle << " of " << active << " subscriptions received nothing yet" << std::endl;
+    }
+}
@@ -0,0 +1,142 @@
+#include "../include/TimerWheel.h"
+
+static size_t roundUpPowerOfTwo(size_t n) {
+    size_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+TimerWheel::TimerWheel(std::chrono::microseconds tick, size_t slotCount) :
+    tickLength(tick), slotMask(roundUpPowerOfTwo(slotCount) - 1),
+    slots(roundUpPowerOfTwo(slotCount)), firing(), index(),
+    origin(Clock::now()), currentTick(0), nextId(1), runningId(0), stopping(false),
+    mtx(), wakeup(), callbackDone(), worker()
+{
+    worker = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+uint64_t TimerWheel::tickOf(Clock::time_point when) const {
+    if (when <= origin) {
+        return 0;
+    }
+    // Round up so a timer never fires before its deadline
+    Clock::duration elapsed = when - origin;
+    return static_cast<uint64_t>((elapsed + tickLength - Clock::duration(1)) / tickLength);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(Clock::time_point deadline, std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    bool wasIdle = index.empty();
+    if (wasIdle) {
+        // Nothing is pending, so the wheel can jump straight to the present instead of
+        // walking every tick that passed while idle
+        uint64_t nowTick = static_cast<uint64_t>((Clock::now() - origin) / tickLength);
+        if (nowTick > currentTick) {
+            currentTick = nowTick;
+        }
+    }
+
+    uint64_t tick = tickOf(deadline);
+    if (tick <= currentTick) {
+        tick = currentTick + 1;
+    }
+
+    TimerId id = nextId++;
+    std::list<Timer>& slot = slots[tick & slotMask];
+    slot.push_back(Timer{id, tick, callback});
+    index[id] = std::make_pair(tick & slotMask, std::prev(slot.end()));
+
+    if (wasIdle) {
+        wakeup.notify_all();
+    }
+    return id;
+}
+
+TimerWheel::TimerId TimerWheel::scheduleAfter(Clock::duration delay, std::function<void()> callback) {
+    return schedule(Clock::now() + delay, callback);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    auto it = index.find(id);
+    if (it != index.end()) {
+        std::list<Timer>& owner = it->second.first == FIRING_SLOT ? firing : slots[it->second.first];
+        owner.erase(it->second.second);
+        index.erase(it);
+        return true;
+    }
+
+    if (std::this_thread::get_id() != worker.get_id()) {
+        callbackDone.wait(lock, [this, id]() { return runningId != id; });
+    }
+    return false;
+}
+
+TimerWheel& TimerWheel::shared() {
+    static TimerWheel wheel(std::chrono::microseconds(10000), 4096);
+    return wheel;
+}
+
+size_t TimerWheel::pending() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return index.size();
+}
+
+void TimerWheel::run() {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while (!stopping) {
+        if (index.empty()) {
+            wakeup.wait(lock, [this]() { return stopping || !index.empty(); });
+            continue;
+        }
+
+        Clock::time_point nextTickTime = origin + tickLength * (currentTick + 1);
+        if (Clock::now() < nextTickTime) {
+            wakeup.wait_until(lock, nextTickTime);
+            continue;
+        }
+
+        currentTick++;
+        size_t slotNumber = currentTick & slotMask;
+        std::list<Timer>& slot = slots[slotNumber];
+        for (auto it = slot.begin(); it != slot.end();) {
+            auto next = std::next(it);
+            if (it->tick <= currentTick) {
+                // Move to the firing list; splice keeps the iterator in index valid
+                firing.splice(firing.end(), slot, it);
+                index[it->id].first = FIRING_SLOT;
+            }
+            it = next;
+        }
+
+        // One at a time, so a timer can still be cancelled while earlier ones run
+        while (!firing.empty()) {
+            Timer timer = firing.front();
+            firing.pop_front();
+            index.erase(timer.id);
+
+            runningId = timer.id;
+            lock.unlock();
+            timer.callback();
+            lock.lock();
+            runningId = 0;
+            callbackDone.notify_all();
+        }
+    }
+}
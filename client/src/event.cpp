@@ -135,6 +135,42 @@ Event::Event(const std::string &frame_body) : team_a_name(""), team_b_name(""),
     }
 }
 
+// convert one json event object into an Event of the given teams
+static Event eventFromJson(json &event, const std::string &team_a_name, const std::string &team_b_name)
+{
+    std::string name = event["event name"];
+    int time = event["time"];
+    std::string description = event["description"];
+    std::map<std::string, std::string> game_updates;
+    std::map<std::string, std::string> team_a_updates;
+    std::map<std::string, std::string> team_b_updates;
+    for (auto &update : event["general game updates"].items())
+    {
+        if (update.value().is_string())
+            game_updates[update.key()] = update.value();
+        else
+            game_updates[update.key()] = update.value().dump();
+    }
+
+    for (auto &update : event["team a updates"].items())
+    {
+        if (update.value().is_string())
+            team_a_updates[update.key()] = update.value();
+        else
+            team_a_updates[update.key()] = update.value().dump();
+    }
+
+    for (auto &update : event["team b updates"].items())
+    {
+        if (update.value().is_string())
+            team_b_updates[update.key()] = update.value();
+        else
+            team_b_updates[update.key()] = update.value().dump();
+    }
+
+    return Event(team_a_name, team_b_name, name, time, game_updates, team_a_updates, team_b_updates, description);
+}
+
 names_and_events parseEventsFile(std::string json_path)
 {
     std::ifstream f(json_path);
@@ -147,39 +183,67 @@ names_and_events parseEventsFile(std::string json_path)
     std::vector<Event> events;
     for (auto &event : data["events"])
     {
-        std::string name = event["event name"];
-        int time = event["time"];
-        std::string description = event["description"];
-        std::map<std::string, std::string> game_updates;
-        std::map<std::string, std::string> team_a_updates;
-        std::map<std::string, std::string> team_b_updates;
-        for (auto &update : event["general game updates"].items())
-        {
-            if (update.value().is_string())
-                game_updates[update.key()] = update.value();
-            else
-                game_updates[update.key()] = update.value().dump();
-        }
+        events.push_back(eventFromJson(event, team_a_name, team_b_name));
+    }
+    names_and_events events_and_names{team_a_name, team_b_name, events};
 
-        for (auto &update : event["team a updates"].items())
-        {
-            if (update.value().is_string())
-                team_a_updates[update.key()] = update.value();
-            else
-                team_a_updates[update.key()] = update.value().dump();
-        }
+    return events_and_names;
+}
 
-        for (auto &update : event["team b updates"].items())
-        {
-            if (update.value().is_string())
-                team_b_updates[update.key()] = update.value();
-            else
-                team_b_updates[update.key()] = update.value().dump();
+void parseEventsHeaderLine(const std::string &line, std::string &team_a_name, std::string &team_b_name)
+{
+    json header = json::parse(line);
+    team_a_name = header["team a"];
+    team_b_name = header["team b"];
+}
+
+Event parseEventLine(const std::string &line, const std::string &team_a_name, const std::string &team_b_name)
+{
+    json event = json::parse(line);
+    return eventFromJson(event, team_a_name, team_b_name);
+}
+
+void peekEventRouting(const std::string &text, size_t begin, std::string &user, std::string &team_a_name, std::string &team_b_name)
+{
+    static const std::string user_field = "user: ";
+    static const std::string team_a_field = "team a: ";
+    static const std::string team_b_field = "team b: ";
+
+    int found = 0;
+    size_t pos = begin;
+    // The routing fields come before the update sections
+    while (pos < text.size() && found < 3) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) {
+            end = text.size();
         }
-        
-        events.push_back(Event(team_a_name, team_b_name, name, time, game_updates, team_a_updates, team_b_updates, description));
+        if (text.compare(pos, user_field.size(), user_field) == 0) {
+            user = text.substr(pos + user_field.size(), end - pos - user_field.size());
+            found++;
+        } else if (text.compare(pos, team_a_field.size(), team_a_field) == 0) {
+            team_a_name = text.substr(pos + team_a_field.size(), end - pos - team_a_field.size());
+            found++;
+        } else if (text.compare(pos, team_b_field.size(), team_b_field) == 0) {
+            team_b_name = text.substr(pos + team_b_field.size(), end - pos - team_b_field.size());
+            found++;
+        } else if (text.compare(pos, end - pos, "general game updates:") == 0) {
+            break;
+        }
+        pos = end + 1;
     }
-    names_and_events events_and_names{team_a_name, team_b_name, events};
+}
 
-    return events_and_names;
-}
\ No newline at end of file
+std::vector<std::pair<size_t, size_t>> splitEventBatch(const std::string &text, size_t begin)
+{
+    std::vector<std::pair<size_t, size_t>> events;
+    size_t start = begin;
+    while (true) {
+        size_t end = text.find(EVENT_SEPARATOR, start);
+        if (end == std::string::npos) {
+            events.emplace_back(start, text.size());
+            return events;
+        }
+        events.emplace_back(start, end);
+        start = end + 1;
+    }
+}
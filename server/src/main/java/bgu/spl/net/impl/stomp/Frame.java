@@ -89,18 +89,15 @@ public class Frame {
         }
         
         Frame frame = new Frame();
-        String cleanMessage = message.replace("\u0000", "");
-        String[] lines = cleanMessage.split("\n", -1); // -1 keeps empty strings
-        
-        if (lines.length < 1) {
-            return null;
-        }
+        // Only the terminating NULL goes: a body with content-length may hold NULs
+        String cleanMessage = message.endsWith("\u0000") ? message.substring(0, message.length() - 1) : message;
+        int headerEnd = cleanMessage.indexOf("\n\n");
+        String head = headerEnd < 0 ? cleanMessage : cleanMessage.substring(0, headerEnd);
+        String[] lines = head.split("\n", -1); // -1 keeps empty strings
         
         frame.setCommand(lines[0].trim());
         
-        // Parse headers until empty line
-        int i = 1;
-        while (i < lines.length && !lines[i].isEmpty()) {
+        for (int i = 1; i < lines.length; i++) {
             String line = lines[i];
             int colonIndex = line.indexOf(':');
             if (colonIndex > 0) {
@@ -108,29 +105,25 @@ public class Frame {
                 String value = line.substring(colonIndex + 1);
                 frame.addHeader(key, value);
             }
-            i++;
         }
         
-        i++; // skip empty line separator
-        
-        // Rest is body
-        StringBuilder bodyBuilder = new StringBuilder();
-        while (i < lines.length) {
-            if (bodyBuilder.length() > 0) {
-                bodyBuilder.append("\n");
-            }
-            bodyBuilder.append(lines[i]);
-            i++;
-        }
-        frame.setBody(bodyBuilder.toString());
+        // Rest is body, byte for byte
+        frame.setBody(headerEnd < 0 ? "" : cleanMessage.substring(headerEnd + 2));
         
         return frame;
     }
 
     // Helper methods to create common frames
     public static Frame createConnected() {
+        return createConnected(null);
+    }
+
+    public static Frame createConnected(String heartBeat) {
         Map<String, String> headers = new HashMap<>();
         headers.put("version", "1.2");
+        if (heartBeat != null) {
+            headers.put("heart-beat", heartBeat);
+        }
         return new Frame("CONNECTED", headers, "");
     }
 
@@ -150,7 +143,16 @@ public class Frame {
     }
 
     public static Frame createMessage(int messageId, String destination, String subscriptionId, String body) {
+        return createMessage(messageId, destination, subscriptionId, body, null);
+    }
+
+    // MESSAGE carrying the sender's own headers too (forwardedHeaders may be null)
+    public static Frame createMessage(int messageId, String destination, String subscriptionId, String body,
+                                      Map<String, String> forwardedHeaders) {
         Map<String, String> headers = new HashMap<>();
+        if (forwardedHeaders != null) {
+            headers.putAll(forwardedHeaders);
+        }
         headers.put("message-id", String.valueOf(messageId));
         headers.put("destination", destination);
         headers.put("subscription", subscriptionId);
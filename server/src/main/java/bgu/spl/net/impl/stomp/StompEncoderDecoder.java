@@ -1,6 +1,7 @@
 package bgu.spl.net.impl.stomp;
 
 import bgu.spl.net.api.MessageEncoderDecoder;
+import java.nio.charset.StandardCharsets;
 import java.util.HashMap;
 import java.util.Map;
 
@@ -16,6 +17,8 @@ public class StompEncoderDecoder implements MessageEncoderDecoder<String> {
     private String command;
     private Map<String, String> headers;
     private StringBuilder bodyBuffer;
+    // Body bytes still expected when the frame has content-length, else -1
+    private int bodyRemaining;
     
     public StompEncoderDecoder() {
         reset();
@@ -27,17 +30,33 @@ public class StompEncoderDecoder implements MessageEncoderDecoder<String> {
         command = null;
         headers = new HashMap<>();
         bodyBuffer = new StringBuilder();
+        bodyRemaining = -1;
     }
     
     @Override
     public String decodeNextByte(byte nextByte) {
+        // Bytes map one to one onto chars (ISO-8859-1), so a binary body survives as is
+        char c = (char) (nextByte & 0xFF);
+        
+        // A body with content-length may hold NULs (a compressed one does)
+        if (currentState == State.BODY && bodyRemaining > 0) {
+            bodyBuffer.append(c);
+            bodyRemaining--;
+            return null;
+        }
+        
+        // ...and ends right there: anything but its NULL means the stream can't be framed.
+        // An empty message is what Frame.parse rejects, so the protocol answers with ERROR.
+        if (currentState == State.BODY && bodyRemaining == 0 && nextByte != 0) {
+            reset();
+            return "";
+        }
+        
         // Check for null terminator - frame is complete
         if (nextByte == 0) {
             return completeFrame();
         }
         
-        char c = (char) nextByte;
-        
         switch (currentState) {
             case COMMAND:
                 return processCommandByte(c);
@@ -51,6 +70,10 @@ public class StompEncoderDecoder implements MessageEncoderDecoder<String> {
     }
     
     private String processCommandByte(char c) {
+        if (lineBuffer.length() == 0 && (c == '\n' || c == '\r')) {
+            // Heart-beat, or an EOL after the previous frame's NULL: not a frame
+            return null;
+        }
         if (c == '\n') {
             // End of command line, move to headers
             command = lineBuffer.toString().trim();
@@ -70,6 +93,7 @@ public class StompEncoderDecoder implements MessageEncoderDecoder<String> {
             if (line.isEmpty() || line.equals("\r")) {
                 // Empty line means headers done, now read body
                 currentState = State.BODY;
+                bodyRemaining = contentLength();
             } else {
                 // Parse header: key:value
                 int colonIndex = line.indexOf(':');
@@ -85,6 +109,18 @@ public class StompEncoderDecoder implements MessageEncoderDecoder<String> {
         return null;
     }
     
+    private int contentLength() {
+        String value = headers.get("content-length");
+        if (value == null) {
+            return -1;
+        }
+        try {
+            return Integer.parseInt(value);
+        } catch (NumberFormatException e) {
+            return -1;
+        }
+    }
+    
     private String processBodyByte(char c) {
         bodyBuffer.append(c);
         return null;
@@ -105,6 +141,6 @@ public class StompEncoderDecoder implements MessageEncoderDecoder<String> {
         if (message == null) {
             return new byte[0];
         }
-        return message.getBytes();
+        return message.getBytes(StandardCharsets.ISO_8859_1);
     }
 }
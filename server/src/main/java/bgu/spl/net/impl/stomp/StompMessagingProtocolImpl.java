@@ -9,23 +9,50 @@ import bgu.spl.net.srv.ConnectionsImpl;
 import java.util.HashMap;
 import java.util.Map;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
 
 public class StompMessagingProtocolImpl implements StompMessagingProtocol<String> {
     
     private int connectionId;
     private Connections<String> connections;
     private String username;
-    private boolean shouldTerminate;
+    // Read by the connection handler's thread after process() returns
+    private volatile boolean shouldTerminate;
     private Map<String, String> subscriptionIdToChannel;
+    // Outbound heart-beats of this connection, null if the client asked for none
+    private ScheduledFuture<?> heartBeatTask;
     
     // Static message ID counter shared across all protocol instances
     private static final AtomicInteger messageIdCounter = new AtomicInteger(0);
     
+    // Per-channel sequence, so subscribers can tell a gap on their channel from
+    // message-ids taken by other channels
+    private static final ConcurrentHashMap<String, AtomicLong> channelSequences = new ConcurrentHashMap<>();
+    
+    // Subscriptions made with ack:client or ack:client-individual, keyed by
+    // "connectionId/subscriptionId"; their MESSAGEs carry an ack header
+    private static final ConcurrentHashMap<String, String> ackModes = new ConcurrentHashMap<>();
+    
+    // Shortest interval at which we send heart-beats; we don't check the client's
+    private static final long SERVER_HEART_BEAT_MS = 1000;
+    
+    // One thread sends the heart-beats of every connection
+    private static final ScheduledExecutorService heartBeats = Executors.newSingleThreadScheduledExecutor(r -> {
+        Thread thread = new Thread(r, "stomp-heart-beats");
+        thread.setDaemon(true);
+        return thread;
+    });
+    
     public StompMessagingProtocolImpl() {
         this.username = null;
         this.shouldTerminate = false;
         this.subscriptionIdToChannel = new HashMap<>();
+        this.heartBeatTask = null;
     }
     
     @Override
@@ -62,6 +89,10 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
             case "UNSUBSCRIBE":
                 handleUnsubscribe(frame);
                 break;
+            case "ACK":
+            case "NACK":
+                handleAck(frame);
+                break;
             case "DISCONNECT":
                 handleDisconnect(frame);
                 break;
@@ -93,9 +124,11 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
             case ADDED_NEW_USER:
                 this.username = login;
                 
-                // Send CONNECTED frame
-                Frame connected = Frame.createConnected();
+                // Send CONNECTED frame, answering a heart-beat header with our own
+                String heartBeat = frame.getHeader("heart-beat");
+                Frame connected = Frame.createConnected(heartBeat != null ? SERVER_HEART_BEAT_MS + ",0" : null);
                 connections.send(connectionId, connected.toString());
+                startHeartBeats(heartBeat);
                 
                 // Send RECEIPT if requested
                 sendReceipt(frame.getHeader("receipt"));
@@ -136,16 +169,21 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
         
         // Parse body to check if this is a game event report
         String body = frame.getBody();
-        if (body != null && body.contains("user:") && body.contains("event name:")) {
+        // A compressed body isn't read here; clients send nothing but reports
+        boolean compressed = frame.getHeader("content-encoding") != null;
+        if (compressed || (body != null && body.contains("user:") && body.contains("event name:"))) {
             // This is a game event - track it as file upload
             // Extract filename from context or use generic name
             String filename = "game_events.json"; // Generic name
             Database.getInstance().trackFileUpload(username, filename, gameChannel);
         }
         
-        // APPROACH 3: Get all subscribers and create unique MESSAGE frame for each
-        // Generate unique message ID (same for all copies of this message)
-        int messageId = messageIdCounter.incrementAndGet();
+        // Headers the sender added (e.g. a session marker) travel with the message;
+        // the ones meant for the server itself don't
+        Map<String, String> forwardedHeaders = new HashMap<>(frame.getHeaders());
+        forwardedHeaders.remove("destination");
+        forwardedHeaders.remove("receipt");
+        forwardedHeaders.remove("transaction");
         
         // Get all subscribers for this channel
         ConcurrentHashMap<Integer, String> subscribers = null;
@@ -153,17 +191,33 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
             subscribers = ((ConnectionsImpl<String>) connections).getChannelSubscribers(destination);
         }
         
-        if (subscribers != null && !subscribers.isEmpty()) {
-            // Create and send unique MESSAGE frame for each subscriber
-            for (Map.Entry<Integer, String> entry : subscribers.entrySet()) {
-                int subscriberConnectionId = entry.getKey();
-                String subscriptionId = entry.getValue();
-                
-                // Create unique MESSAGE frame with subscriber-specific subscription header
-                Frame messageFrame = Frame.createMessage(messageId, destination, subscriptionId, frame.getBody());
-                
-                // Send directly to this connection (NOT via broadcast)
-                connections.send(subscriberConnectionId, messageFrame.toString());
+        // Numbering and fan-out happen under the channel's lock: otherwise two senders
+        // could hand a subscriber channel-seq 5 before 4, which reads as reordering
+        AtomicLong channelSequence = channelSequences.computeIfAbsent(destination, d -> new AtomicLong(0));
+        synchronized (channelSequence) {
+            // APPROACH 3: Get all subscribers and create unique MESSAGE frame for each
+            // Generate unique message ID (same for all copies of this message)
+            int messageId = messageIdCounter.incrementAndGet();
+            forwardedHeaders.put("channel-seq", String.valueOf(channelSequence.incrementAndGet()));
+            
+            if (subscribers != null && !subscribers.isEmpty()) {
+                // Create and send unique MESSAGE frame for each subscriber
+                for (Map.Entry<Integer, String> entry : subscribers.entrySet()) {
+                    int subscriberConnectionId = entry.getKey();
+                    String subscriptionId = entry.getValue();
+                    
+                    // Create unique MESSAGE frame with subscriber-specific subscription header
+                    Map<String, String> headers = forwardedHeaders;
+                    if (ackModes.containsKey(subscriberConnectionId + "/" + subscriptionId)) {
+                        headers = new HashMap<>(forwardedHeaders);
+                        headers.put("ack", String.valueOf(messageId));
+                    }
+                    Frame messageFrame = Frame.createMessage(messageId, destination, subscriptionId, frame.getBody(),
+                                                             headers);
+                    
+                    // Send directly to this connection (NOT via broadcast)
+                    connections.send(subscriberConnectionId, messageFrame.toString());
+                }
             }
         }
         
@@ -180,8 +234,17 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
             return;
         }
         
+        String ack = frame.getHeader("ack");
+        if (ack != null && !ack.equals("auto") && !ack.equals("client") && !ack.equals("client-individual")) {
+            sendError("Invalid ack mode: " + ack, frame.getHeader("receipt"));
+            return;
+        }
+        
         // Store subscription mapping
         subscriptionIdToChannel.put(subscriptionId, destination);
+        if (ack != null && !ack.equals("auto")) {
+            ackModes.put(connectionId + "/" + subscriptionId, ack);
+        }
         
         // Register with connections manager
         connections.subscribe(connectionId, destination, subscriptionId);
@@ -207,12 +270,25 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
         
         // Remove subscription
         subscriptionIdToChannel.remove(subscriptionId);
+        ackModes.remove(connectionId + "/" + subscriptionId);
         connections.unsubscribe(connectionId, subscriptionId);
         
         // Send RECEIPT if requested
         sendReceipt(frame.getHeader("receipt"));
     }
     
+    // Acknowledgements are accepted but nothing is redelivered: messages are not kept
+    // after they are sent, so an ACK only has to name a message
+    private void handleAck(Frame frame) {
+        if (frame.getHeader("id") == null) {
+            sendError(frame.getCommand() + " must include id header", frame.getHeader("receipt"));
+            return;
+        }
+        
+        // Send RECEIPT if requested
+        sendReceipt(frame.getHeader("receipt"));
+    }
+    
     private void handleDisconnect(Frame frame) {
         String receiptId = frame.getHeader("receipt");
         
@@ -225,10 +301,13 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
         // Send receipt acknowledgment
         sendReceipt(receiptId);
         
+        forgetAckModes();
+        
         // CRITICAL: Update logout time in database (SAFETY #1) 
         Database.getInstance().logout(connectionId);
         
         // Mark for disconnection
+        stopHeartBeats();
         shouldTerminate = true;
     }
     
@@ -250,6 +329,47 @@ public class StompMessagingProtocolImpl implements StompMessagingProtocol<String
         connections.send(connectionId, error.toString());
         
         // CRITICAL: Must close connection after ERROR
+        forgetAckModes();
+        stopHeartBeats();
         shouldTerminate = true;
     }
+    
+    // The connection is ending: its subscriptions no longer need ack headers
+    private void forgetAckModes() {
+        for (String subscriptionId : subscriptionIdToChannel.keySet()) {
+            ackModes.remove(connectionId + "/" + subscriptionId);
+        }
+    }
+    
+    // heartBeat is the client's "cx,cy": it wants a beat at least every cy ms, 0 for none
+    private void startHeartBeats(String heartBeat) {
+        if (heartBeat == null) {
+            return;
+        }
+        long wanted;
+        try {
+            wanted = Long.parseLong(heartBeat.substring(heartBeat.indexOf(',') + 1).trim());
+        } catch (NumberFormatException e) {
+            return;
+        }
+        if (wanted <= 0) {
+            return;
+        }
+        long every = Math.max(SERVER_HEART_BEAT_MS, wanted);
+        int id = connectionId;
+        Connections<String> target = connections;
+        heartBeatTask = heartBeats.scheduleAtFixedRate(() -> {
+            // A lone EOL; send() fails once the connection is gone
+            if (!target.send(id, "\n")) {
+                throw new IllegalStateException("connection " + id + " closed");
+            }
+        }, every, every, TimeUnit.MILLISECONDS);
+    }
+    
+    private void stopHeartBeats() {
+        if (heartBeatTask != null) {
+            heartBeatTask.cancel(false);
+            heartBeatTask = null;
+        }
+    }
 }
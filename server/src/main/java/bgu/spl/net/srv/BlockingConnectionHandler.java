@@ -45,6 +45,10 @@ public class BlockingConnectionHandler<T> implements Runnable, ConnectionHandler
 
         } catch (IOException ex) {
             ex.printStackTrace();
+        } finally {
+            // Also when the client left without DISCONNECT: later sends to it (heart-beats)
+            // then fail instead of writing to a closed socket
+            connections.disconnect(connectionId);
         }
     }
 
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <boost/asio.hpp>
+#include "../client/include/ConnectionHandler.h"
+#include "../client/include/AckBatcher.h"
+#include "../client/include/Frame.h"
+
+// Throughput of an acking subscription at different ACK batch sizes.
+// A loopback stand-in broker keeps at most WINDOW messages unacknowledged on the
+// subscription (a prefetch window, as brokers apply to client acks) and counts the ACKs
+// it gets: in client mode an ACK covers every message up to it, in client-individual
+// mode just the one. The client side is the real ConnectionHandler and AckBatcher, each
+// MESSAGE parsed before it is acked.
+
+using boost::asio::ip::tcp;
+typedef std::chrono::steady_clock Clock;
+
+static const int WINDOW = 256;
+
+static std::string messageFrame(int i) {
+    std::string body =
+        "user: meni\nteam a: Germany\nteam b: Japan\nevent name: event " + std::to_string(i % 12) +
+        "\ntime: " + std::to_string(i) +
+        "\ngeneral game updates:\n\tactive: true\nteam a updates:\n\tpossession: 51%\nteam b updates:\n"
+        "\tpossession: 49%\ndescription:\nCommentary for event " + std::to_string(i) + ".\n";
+    return "MESSAGE\nsubscription:0\nmessage-id:" + std::to_string(i) + "\nack:" + std::to_string(i) +
+           "\ndestination:/Germany_Japan\n\n" + body + '\0';
+}
+
+struct BrokerCounts {
+    uint64_t ackFrames;
+    uint64_t reads;
+};
+
+// Sends total messages, each as soon as the window has room, until all are acked
+static BrokerCounts broker(tcp::acceptor& acceptor, boost::asio::io_service& io, int total, bool cumulative) {
+    tcp::socket socket(io);
+    acceptor.accept(socket);
+    socket.set_option(tcp::no_delay(true));
+
+    BrokerCounts counts{0, 0};
+    int sent = 0;
+    int acked = 0;
+    std::string inbox;
+    std::vector<char> buffer(64 * 1024);
+    boost::system::error_code error;
+    while (acked < total && !error) {
+        std::string chunk;
+        while (sent - acked < WINDOW && sent < total) {
+            chunk += messageFrame(sent++);
+        }
+        if (!chunk.empty()) {
+            boost::asio::write(socket, boost::asio::buffer(chunk), error);
+        }
+        size_t received = socket.read_some(boost::asio::buffer(buffer), error);
+        counts.reads++;
+        inbox.append(buffer.data(), received);
+        size_t pos = 0;
+        size_t end;
+        while ((end = inbox.find('\0', pos)) != std::string::npos) {
+            std::string frame = inbox.substr(pos, end - pos);
+            pos = end + 1;
+            size_t start = frame.find_first_not_of("\r\n");
+            if (start == std::string::npos || frame.compare(start, 4, "ACK\n") != 0) {
+                continue;
+            }
+            counts.ackFrames++;
+            int id = std::stoi(Frame::peekHeader(frame.substr(start), "id"));
+            acked = cumulative ? std::max(acked, id + 1) : acked + 1;
+        }
+        inbox.erase(0, pos);
+    }
+    socket.close();
+    return counts;
+}
+
+static void runCase(AckMode mode, size_t batchSize, int total) {
+    boost::asio::io_service io;
+    // ConnectionHandler takes a short, so not an ephemeral port
+    const short port = 17778;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port));
+    BrokerCounts counts{0, 0};
+    std::thread server([&]() { counts = broker(acceptor, io, total, mode == AckMode::CLIENT); });
+
+    Clock::time_point start = Clock::now();
+    {
+        ConnectionHandler handler("127.0.0.1", port);
+        std::mutex sendMtx;
+        auto flush = [&handler, &sendMtx](AckBatcher& batcher) {
+            std::string wire;
+            std::lock_guard<std::mutex> lock(sendMtx);
+            if (batcher.drain(wire, false) > 0) {
+                handler.sendBytes(wire.data(), wire.size());
+            }
+        };
+        AckBatcher* self = nullptr;
+        AckBatcher batcher([&flush, &self]() { flush(*self); });
+        self = &batcher;
+        batcher.setBatchSize(batchSize);
+        batcher.setInterval(std::chrono::milliseconds(5));
+        batcher.track(0, mode);
+
+        if (handler.connect()) {
+            std::vector<std::string> frames;
+            while (handler.getFrames(frames, '\0')) {
+                for (const std::string& frame : frames) {
+                    Frame parsed = Frame::parse(frame);
+                    (void)parsed;
+                    if (batcher.onHandled(frame)) {
+                        flush(batcher);
+                    }
+                }
+                frames.clear();
+            }
+        }
+        batcher.reset();
+    }
+    server.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << std::left << std::setw(18) << AckBatcher::modeName(mode) << std::right << std::setw(6) << batchSize
+              << std::setw(14) << static_cast<uint64_t>(total / seconds)
+              << std::setw(12) << counts.ackFrames << std::setw(12) << counts.reads << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int total = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::cout << "=== ACK batching benchmark: " << total << " messages, window " << WINDOW << " ===" << std::endl;
+    std::cout << std::left << std::setw(18) << "mode" << std::right << std::setw(6) << "batch"
+              << std::setw(14) << "messages/s" << std::setw(12) << "ACK frames" << std::setw(12) << "ACK reads"
+              << std::endl;
+
+    size_t batches[] = {1, 8, 32, 128};
+    for (size_t batch : batches) {
+        runCase(AckMode::CLIENT, batch, total);
+    }
+    for (size_t batch : batches) {
+        runCase(AckMode::CLIENT_INDIVIDUAL, batch, total);
+    }
+    return 0;
+}
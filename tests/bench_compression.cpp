@@ -0,0 +1,95 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include "../client/include/FrameCompression.h"
+#include "../client/include/Frame.h"
+#include "../client/include/event.h"
+
+// Compression of report bodies with up to N events per SEND (report --batch N), through
+// FrameCompression as the client uses it: ratio, and time per frame to compress on the
+// way out and decompress on the way in. Bigger bodies repeat more (field names, team
+// names), so batching and compression add up.
+
+typedef std::chrono::steady_clock Clock;
+
+static std::string eventBody(int i) {
+    return "user: meni\nteam a: Germany\nteam b: Japan\nevent name: event " + std::to_string(i % 12) +
+           "\ntime: " + std::to_string(i) +
+           "\ngeneral game updates:\n\tactive: true\nteam a updates:\n\tpossession: 51%\nteam b updates:\n"
+           "\tpossession: 49%\ndescription:\nCommentary for event " + std::to_string(i) + ".\n";
+}
+
+static void runCase(const std::vector<std::string>& bodies, size_t batch) {
+    FrameCompression compression;
+    compression.setEnabled(true);
+    compression.setThreshold(0);
+
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < bodies.size(); i += batch) {
+        size_t end = std::min(i + batch, bodies.size());
+        std::string body;
+        for (size_t j = i; j < end; j++) {
+            if (j > i) {
+                body += EVENT_SEPARATOR;
+            }
+            body += bodies[j];
+        }
+        Frame frame("SEND");
+        frame.addHeader("destination", "/Germany_Japan");
+        frame.setBody(body);
+        frames.push_back(frame);
+    }
+
+    size_t plainBytes = 0;
+    size_t encodedBytes = 0;
+    std::vector<std::string> messages;
+    messages.reserve(frames.size());
+    Clock::time_point start = Clock::now();
+    for (Frame& frame : frames) {
+        plainBytes += frame.getBody().size();
+        compression.encode(frame);
+        encodedBytes += frame.getBody().size();
+        messages.push_back("MESSAGE\nsubscription:0\n" + frame.toString().substr(5));
+    }
+    double encodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    size_t failed = 0;
+    std::string decoded;
+    start = Clock::now();
+    for (const std::string& message : messages) {
+        if (compression.decode(message, decoded) == FrameCompression::Result::FAILED) {
+            failed++;
+        }
+    }
+    double decodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (failed > 0) {
+        std::cout << "  " << failed << " frames failed to decode!" << std::endl;
+    }
+
+    std::cout << std::setw(6) << batch << std::setw(10) << frames.size() << std::setw(14) << plainBytes / frames.size()
+              << std::setw(12) << std::fixed << std::setprecision(2) << static_cast<double>(plainBytes) / encodedBytes
+              << std::setw(14) << std::setprecision(0) << encodeSeconds * 1e9 / frames.size()
+              << std::setw(14) << decodeSeconds * 1e9 / frames.size()
+              << std::setw(10) << plainBytes / encodeSeconds / (1 << 20)
+              << std::setw(10) << plainBytes / decodeSeconds / (1 << 20) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int total = argc > 1 ? std::atoi(argv[1]) : 50000;
+    std::vector<std::string> bodies;
+    bodies.reserve(total);
+    for (int i = 0; i < total; i++) {
+        bodies.push_back(eventBody(i));
+    }
+
+    std::cout << "=== Body compression benchmark (lz4): " << total << " events ===" << std::endl;
+    std::cout << std::setw(6) << "batch" << std::setw(10) << "frames" << std::setw(14) << "body bytes"
+              << std::setw(12) << "ratio" << std::setw(14) << "compress ns" << std::setw(14) << "decompress ns"
+              << std::setw(10) << "in MB/s" << std::setw(10) << "out MB/s" << std::endl;
+    size_t batches[] = {1, 4, 16, 64};
+    for (size_t batch : batches) {
+        runCase(bodies, batch);
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "../client/include/ShardedEventStore.h"
+#include "../client/include/Histogram.h"
+
+// Socket-thread latency while summaries run in a loop on the stdin thread.
+// The "socket thread" stores one received event every 100us and records how long each
+// store takes; the "stdin thread" summarizes the same game back to back.
+// Compared: one mutex around a GameEventStore (the protocol before sharding) and the
+// ShardedEventStore the protocol uses now.
+
+typedef std::chrono::steady_clock Clock;
+
+static Event makeEvent(int i) {
+    std::map<std::string, std::string> general;
+    std::map<std::string, std::string> team_a;
+    std::map<std::string, std::string> team_b;
+    general["active"] = "true";
+    team_a["possession"] = std::to_string(40 + i % 20) + "%";
+    team_b["possession"] = std::to_string(60 - i % 20) + "%";
+    return Event("Germany", "Japan", "event " + std::to_string(i % 12), i, general, team_a, team_b,
+                 "Commentary for event " + std::to_string(i) +
+                 ": a long description of the play, the players involved and how the crowd reacted to it.");
+}
+
+// store(i) stores event i; summarize() renders one summary
+template <typename Store, typename Summarize>
+static void runCase(const char* name, int prefill, Store store, Summarize summarize) {
+    for (int i = 0; i < prefill; i++) {
+        store(i);
+    }
+
+    std::atomic<bool> done(false);
+    std::atomic<int> summaries(0);
+    std::thread reader([&]() {
+        while (!done) {
+            summarize();
+            summaries++;
+        }
+    });
+
+    Histogram latency;
+    Clock::time_point end = Clock::now() + std::chrono::seconds(2);
+    Clock::time_point next = Clock::now();
+    for (int i = prefill; Clock::now() < end; i++) {
+        std::this_thread::sleep_until(next);
+        next += std::chrono::microseconds(100);
+        Clock::time_point start = Clock::now();
+        store(i);
+        latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count()));
+    }
+    done = true;
+    reader.join();
+
+    std::cout << "\n" << name << " (" << summaries << " summaries of " << prefill << "+ events)" << std::endl;
+    latency.print(std::cout, "  store latency", "us");
+}
+
+int main(int argc, char* argv[]) {
+    int prefill = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::cout << "=== Contention benchmark: socket-thread store latency during summaries ===" << std::endl;
+
+    {
+        std::mutex mtx;
+        GameEventStore store;
+        runCase("single mutex", prefill,
+            [&](int i) {
+                Event event = makeEvent(i);
+                std::lock_guard<std::mutex> lock(mtx);
+                store.add("Germany_Japan", "meni", event);
+            },
+            [&]() {
+                std::string summary;
+                std::lock_guard<std::mutex> lock(mtx);
+                store.summarize("Germany_Japan", "meni", summary);
+            });
+    }
+
+    {
+        ShardedEventStore store;
+        runCase("sharded store", prefill,
+            [&](int i) {
+                store.add("Germany_Japan", "meni", makeEvent(i));
+            },
+            [&]() {
+                std::string summary;
+                store.read("Germany_Japan", [&](const GameEventStore& s) {
+                    s.summarize("Germany_Japan", "meni", summary);
+                });
+            });
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <boost/asio.hpp>
+#include "../client/include/ConnectionHandler.h"
+#include "../client/include/InboundDispatcher.h"
+#include "../client/include/Frame.h"
+#include "../client/include/event.h"
+#include "../client/include/Histogram.h"
+
+// Join-receipt latency while a heavy publisher floods the connection.
+// A loopback "server" writes MESSAGE frames in bursts and, every millisecond, a RECEIPT
+// stamped with its send time; the client side measures how long each RECEIPT takes to be
+// handled. Compared, over the real ConnectionHandler:
+//   arrival order - one frame at a time, each handled before the next (the protocol
+//                   before inbound workers and lanes)
+//   lanes, inline - batches with control frames handled first, MESSAGEs inline after them
+//   lanes, workers - batches with control frames first, MESSAGEs on InboundDispatcher
+
+using boost::asio::ip::tcp;
+typedef std::chrono::steady_clock Clock;
+
+static uint64_t nowNs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+static std::string messageFrame(int i) {
+    std::string body =
+        "user: meni\nteam a: Germany\nteam b: Japan\nevent name: event " + std::to_string(i % 12) +
+        "\ntime: " + std::to_string(i) +
+        "\ngeneral game updates:\n\tactive: true\nteam a updates:\n\tpossession: 51%\nteam b updates:\n"
+        "\tpossession: 49%\ndescription:\nCommentary for event " + std::to_string(i) +
+        ": a long description of the play, the players involved and how the crowd reacted to it.\n";
+    return "MESSAGE\nsubscription:0\nmessage-id:" + std::to_string(i) + "\ndestination:/Germany_Japan\n\n" +
+           body + '\0';
+}
+
+// Bursts of burstSize MESSAGEs every 100ms, a RECEIPT every 1ms, for the given time
+static void publish(boost::asio::io_service& io, tcp::acceptor& acceptor, int burstSize,
+                    std::chrono::milliseconds duration) {
+    tcp::socket socket(io);
+    acceptor.accept(socket);
+
+    Clock::time_point end = Clock::now() + duration;
+    Clock::time_point nextBurst = Clock::now();
+    Clock::time_point nextReceipt = Clock::now();
+    int sent = 0;
+    int burstLeft = 0;
+    boost::system::error_code error;
+    while (Clock::now() < end && !error) {
+        std::string chunk;
+        if (Clock::now() >= nextReceipt) {
+            chunk += "RECEIPT\nreceipt-id:" + std::to_string(nowNs()) + "\n\n" + '\0';
+            nextReceipt += std::chrono::milliseconds(1);
+        }
+        if (Clock::now() >= nextBurst) {
+            burstLeft += burstSize;
+            nextBurst += std::chrono::milliseconds(100);
+        }
+        // Written in slices so receipts keep interleaving with the burst
+        for (int i = 0; i < 64 && burstLeft > 0; i++, burstLeft--) {
+            chunk += messageFrame(sent++);
+        }
+        if (chunk.empty()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        boost::asio::write(socket, boost::asio::buffer(chunk), error);
+    }
+    socket.close();
+}
+
+// A MESSAGE costs what the protocol spends on it: a full parse and an Event
+static void handleMessage(const std::string& frame) {
+    Frame parsed = Frame::parse(frame);
+    Event event(parsed.getBody());
+    (void)event;
+}
+
+static void handleReceipt(const std::string& frame, Histogram& latency) {
+    uint64_t sent = std::stoull(Frame::peekHeader(frame, "receipt-id"));
+    latency.record((nowNs() - sent) / 1000);
+}
+
+// receive(handler, latency) runs the client loop until the publisher hangs up
+static void runCase(const char* name, int burstSize,
+                    std::function<void(ConnectionHandler&, Histogram&)> receive) {
+    boost::asio::io_service io;
+    // ConnectionHandler takes a short, so not an ephemeral port
+    const short port = 17777;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port));
+    std::thread publisher([&]() { publish(io, acceptor, burstSize, std::chrono::seconds(2)); });
+
+    Histogram latency;
+    {
+        ConnectionHandler handler("127.0.0.1", port);
+        if (handler.connect()) {
+            receive(handler, latency);
+        }
+    }
+    publisher.join();
+
+    std::cout << "\n" << name << " (bursts of " << burstSize << " messages)" << std::endl;
+    latency.print(std::cout, "  receipt latency", "us");
+}
+
+int main(int argc, char* argv[]) {
+    int burstSize = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::cout << "=== Control-frame latency benchmark: RECEIPTs during a MESSAGE flood ===" << std::endl;
+
+    runCase("arrival order", burstSize, [](ConnectionHandler& handler, Histogram& latency) {
+        std::string frame;
+        while (handler.getFrameAscii(frame, '\0')) {
+            if (Frame::peekCommand(frame) == "RECEIPT") {
+                handleReceipt(frame, latency);
+            } else {
+                handleMessage(frame);
+            }
+            frame.clear();
+        }
+    });
+
+    auto lanes = [](ConnectionHandler& handler, Histogram& latency, InboundDispatcher& dispatcher) {
+        std::vector<std::string> frames;
+        while (handler.getFrames(frames, '\0')) {
+            std::vector<std::string*> data;
+            for (std::string& frame : frames) {
+                if (Frame::peekCommand(frame) == "RECEIPT") {
+                    handleReceipt(frame, latency);
+                } else {
+                    data.push_back(&frame);
+                }
+            }
+            for (std::string* frame : data) {
+                dispatcher.dispatch("/Germany_Japan", std::move(*frame));
+            }
+            frames.clear();
+        }
+        dispatcher.flush();
+    };
+
+    runCase("lanes, inline", burstSize, [&](ConnectionHandler& handler, Histogram& latency) {
+        InboundDispatcher dispatcher(handleMessage, 0);
+        lanes(handler, latency, dispatcher);
+    });
+
+    runCase("lanes, workers", burstSize, [&](ConnectionHandler& handler, Histogram& latency) {
+        InboundDispatcher dispatcher(handleMessage, 2);
+        lanes(handler, latency, dispatcher);
+    });
+    return 0;
+}
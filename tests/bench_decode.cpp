@@ -0,0 +1,103 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../client/include/ShardedEventStore.h"
+#include "../client/include/Frame.h"
+
+// Ingest CPU and memory per received MESSAGE, eager against lazy decoding, and what the
+// first summary of the game then costs (lazy pays the decoding there).
+// Each case replays the MESSAGE handling of StompProtocol over the same frames and runs
+// in its own process so RSS readings don't leak between cases.
+
+static long rssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+    return 0;
+}
+
+static std::string messageFrame(int i) {
+    std::string body =
+        "user: meni\nteam a: Germany\nteam b: Japan\nevent name: event " + std::to_string(i % 12) +
+        "\ntime: " + std::to_string(i) +
+        "\ngeneral game updates:\n\tactive: true\nteam a updates:\n\tpossession: " + std::to_string(40 + i % 20) +
+        "%\nteam b updates:\n\tpossession: " + std::to_string(60 - i % 20) + "%\ndescription:\nCommentary for event " +
+        std::to_string(i) + ": a long description of the play, the players involved and how the crowd reacted to it.\n";
+    return "MESSAGE\nsubscription:0\nmessage-id:" + std::to_string(i) + "\ndestination:/Germany_Japan\n\n" + body;
+}
+
+static void ingestEager(ShardedEventStore& store, const std::string& frameStr) {
+    std::string body = Frame::parse(frameStr).getBody();
+    Event event(body);
+    std::string user;
+    std::stringstream bodyStream(body);
+    std::string line;
+    while (std::getline(bodyStream, line)) {
+        if (line.find("user: ") == 0) {
+            user = line.substr(6);
+            break;
+        }
+    }
+    store.add(event.get_team_a_name() + "_" + event.get_team_b_name(), user, event);
+}
+
+static void ingestLazy(ShardedEventStore& store, const std::string& frameStr) {
+    size_t bodyStart = Frame::peekBodyOffset(frameStr);
+    std::string user;
+    std::string team_a;
+    std::string team_b;
+    peekEventRouting(frameStr, bodyStart, user, team_a, team_b);
+    store.addRaw(team_a + "_" + team_b, user, frameStr.data() + bodyStart, frameStr.size() - bodyStart);
+}
+
+static void runCase(bool lazy, int n) {
+    std::vector<std::string> frames;
+    frames.reserve(n);
+    for (int i = 0; i < n; i++) {
+        frames.push_back(messageFrame(i));
+    }
+
+    ShardedEventStore store;
+    long baseline = rssKb();
+    std::clock_t cpuStart = std::clock();
+    for (const std::string& frame : frames) {
+        if (lazy) {
+            ingestLazy(store, frame);
+        } else {
+            ingestEager(store, frame);
+        }
+    }
+    double cpuUs = 1e6 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    long stored = rssKb();
+
+    auto start = std::chrono::steady_clock::now();
+    std::string summary;
+    store.read("Germany_Japan", [&](const GameEventStore& s) { s.summarize("Germany_Japan", "meni", summary); });
+    double summaryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << (lazy ? "lazy  " : "eager ") << n << " messages: ingest " << cpuUs / n << " us CPU/message, "
+              << (stored - baseline) * 1024 / n << " bytes/message, first summary " << summaryMs << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::cout << "=== Decoding benchmark: eager vs lazy MESSAGE ingest ===" << std::endl;
+    for (bool lazy : {false, true}) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            runCase(lazy, n);
+            _exit(0);
+        }
+        waitpid(pid, nullptr, 0);
+    }
+    return 0;
+}
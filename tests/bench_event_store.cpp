@@ -0,0 +1,134 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../client/include/GameEventStore.h"
+
+// Summary time and memory of the columnar GameEventStore against the previous
+// map<game, map<user, vector<Event>>> layout, at 10k / 100k / 1M events per game,
+// plus full-text search latency over the stored descriptions.
+// Every case runs in its own process so RSS readings don't leak between cases.
+
+static long rssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return std::atol(line.c_str() + 6);
+        }
+    }
+    return 0;
+}
+
+static Event makeEvent(int i) {
+    std::map<std::string, std::string> general;
+    std::map<std::string, std::string> team_a;
+    std::map<std::string, std::string> team_b;
+    general["active"] = (i % 50 == 0) ? "false" : "true";
+    team_a["possession"] = std::to_string(40 + i % 20) + "%";
+    if (i % 7 == 0) team_a["goals"] = std::to_string(i / 7 % 10);
+    team_b["possession"] = std::to_string(60 - i % 20) + "%";
+    // Reports arrive mostly in order with some stragglers
+    int time = (i % 10 == 0) ? i - 5 : i;
+    return Event("Germany", "Japan", "event " + std::to_string(i % 12), time, general, team_a, team_b,
+                 "Commentary for event " + std::to_string(i) +
+                 ": a long description of the play, the players involved and how the crowd reacted to it.");
+}
+
+// The summary as handleSummary produced it before the columnar store
+static std::string legacySummary(std::vector<Event> events) {
+    std::map<std::string, std::string> general_stats;
+    std::map<std::string, std::string> team_a_stats;
+    std::map<std::string, std::string> team_b_stats;
+    for (const Event& ev : events) {
+        for (const auto& kv : ev.get_game_updates()) general_stats[kv.first] = kv.second;
+        for (const auto& kv : ev.get_team_a_updates()) team_a_stats[kv.first] = kv.second;
+        for (const auto& kv : ev.get_team_b_updates()) team_b_stats[kv.first] = kv.second;
+    }
+
+    std::ostringstream out;
+    out << events[0].get_team_a_name() << " vs " << events[0].get_team_b_name() << "\n";
+    out << "Game stats:\nGeneral stats:\n";
+    for (const auto& kv : general_stats) out << kv.first << ": " << kv.second << "\n";
+    out << events[0].get_team_a_name() << " stats:\n";
+    for (const auto& kv : team_a_stats) out << kv.first << ": " << kv.second << "\n";
+    out << events[0].get_team_b_name() << " stats:\n";
+    for (const auto& kv : team_b_stats) out << kv.first << ": " << kv.second << "\n";
+
+    std::sort(events.begin(), events.end(),
+        [](const Event& a, const Event& b) { return a.get_time() < b.get_time(); });
+    out << "Game event reports:\n";
+    for (const Event& ev : events) {
+        out << ev.get_time() << " - " << ev.get_name() << ":\n\n" << ev.get_discription() << "\n\n\n";
+    }
+    return out.str();
+}
+
+static void runCase(bool columnar, int n) {
+    long baseline = rssKb();
+    std::string summary;
+    double ms = 0;
+    const int rounds = 3;
+
+    if (columnar) {
+        GameEventStore store;
+        for (int i = 0; i < n; i++) store.add("Germany_Japan", "meni", makeEvent(i));
+        long stored = rssKb();
+        for (int r = 0; r < rounds; r++) {
+            auto start = std::chrono::steady_clock::now();
+            store.summarize("Germany_Japan", "meni", summary);
+            ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::cout << "columnar " << n << " events: summary " << ms / rounds << " ms, store RSS "
+                  << (stored - baseline) / 1024 << " MB (search index "
+                  << store.textIndexMemoryBytes() / (1024 * 1024) << " MB)" << std::endl;
+
+        // A rare term ANDed with one in every description, and an OR of two rare terms
+        const std::vector<std::vector<std::string>> searches = {{"crowd", std::to_string(n / 2)},
+                                                                {std::to_string(n / 3), std::to_string(n / 4)}};
+        for (size_t q = 0; q < searches.size(); q++) {
+            size_t matches = 0;
+            auto start = std::chrono::steady_clock::now();
+            store.search("Germany_Japan", searches[q], q == 1, summary, matches);
+            double searchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "         search " << (q == 1 ? "OR " : "AND") << ": " << matches << " matches, "
+                      << searchMs << " ms" << std::endl;
+        }
+    } else {
+        std::map<std::string, std::map<std::string, std::vector<Event>>> gameEvents;
+        for (int i = 0; i < n; i++) gameEvents["Germany_Japan"]["meni"].push_back(makeEvent(i));
+        long stored = rssKb();
+        for (int r = 0; r < rounds; r++) {
+            auto start = std::chrono::steady_clock::now();
+            // The copy under the lock was part of every summary
+            summary = legacySummary(gameEvents["Germany_Japan"]["meni"]);
+            ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        std::cout << "legacy   " << n << " events: summary " << ms / rounds << " ms, store RSS "
+                  << (stored - baseline) / 1024 << " MB" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {10000, 100000, 1000000};
+    if (argc > 1) {
+        sizes = {std::atoi(argv[1])};
+    }
+
+    std::cout << "=== Event store benchmark: summary time and RSS ===" << std::endl;
+    for (int n : sizes) {
+        for (bool columnar : {false, true}) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                runCase(columnar, n);
+                _exit(0);
+            }
+            waitpid(pid, nullptr, 0);
+        }
+    }
+    return 0;
+}
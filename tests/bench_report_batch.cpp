@@ -0,0 +1,123 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <boost/asio.hpp>
+#include "../client/include/ConnectionHandler.h"
+#include "../client/include/Frame.h"
+#include "../client/include/event.h"
+
+// Report throughput and wire size with up to N events per SEND (report --batch N).
+// The client side packs events the way handleReport does and writes each frame through
+// the real ConnectionHandler; a loopback sink does the per-frame work of a broker (a
+// full frame parse) and then decodes the events as a receiver would. Timed until the
+// sink has decoded every event.
+
+using boost::asio::ip::tcp;
+typedef std::chrono::steady_clock Clock;
+
+static std::string eventBody(int i) {
+    return "user: meni\nteam a: Germany\nteam b: Japan\nevent name: event " + std::to_string(i % 12) +
+           "\ntime: " + std::to_string(i) +
+           "\ngeneral game updates:\n\tactive: true\nteam a updates:\n\tpossession: 51%\nteam b updates:\n"
+           "\tpossession: 49%\ndescription:\nCommentary for event " + std::to_string(i) + ".\n";
+}
+
+// Reads frames until the client hangs up; returns the number of events decoded
+static size_t sink(tcp::acceptor& acceptor, boost::asio::io_service& io) {
+    tcp::socket socket(io);
+    acceptor.accept(socket);
+    size_t events = 0;
+    std::string inbox;
+    std::vector<char> buffer(64 * 1024);
+    boost::system::error_code error;
+    while (!error) {
+        size_t received = socket.read_some(boost::asio::buffer(buffer), error);
+        inbox.append(buffer.data(), received);
+        size_t pos = 0;
+        size_t end;
+        while ((end = inbox.find('\0', pos)) != std::string::npos) {
+            Frame frame = Frame::parse(inbox.substr(pos, end - pos));
+            pos = end + 1;
+            // As the client's handleMessage decodes them
+            const std::string& body = frame.getBody();
+            for (const auto& range : splitEventBatch(body, 0)) {
+                Event event(body.substr(range.first, range.second - range.first));
+                events++;
+            }
+        }
+        inbox.erase(0, pos);
+    }
+    return events;
+}
+
+static void runCase(const std::vector<std::string>& bodies, size_t batch) {
+    boost::asio::io_service io;
+    // ConnectionHandler takes a short, so not an ephemeral port
+    const short port = 17779;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port));
+    size_t decoded = 0;
+    std::thread server([&]() { decoded = sink(acceptor, io); });
+
+    size_t frames = 0;
+    size_t wireBytes = 0;
+    Clock::time_point start = Clock::now();
+    {
+        ConnectionHandler handler("127.0.0.1", port);
+        if (handler.connect()) {
+            for (size_t i = 0; i < bodies.size(); i += batch) {
+                size_t end = std::min(i + batch, bodies.size());
+                std::string body;
+                for (size_t j = i; j < end; j++) {
+                    if (j > i) {
+                        body += EVENT_SEPARATOR;
+                    }
+                    body += bodies[j];
+                }
+                Frame frame("SEND");
+                frame.addHeader("destination", "/Germany_Japan");
+                frame.addHeader("sender-session", "5f2c9a41d07e3b68");
+                frame.addHeader("send-ts", std::to_string(Clock::now().time_since_epoch().count() / 1000));
+                if (end - i > 1) {
+                    frame.addHeader("event-count", std::to_string(end - i));
+                }
+                frame.setBody(body);
+                std::string wire = frame.toString();
+                handler.sendFrameAscii(wire, '\0');
+                frames++;
+                wireBytes += wire.size() + 1;
+            }
+        }
+        handler.close();
+        server.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (decoded != bodies.size()) {
+        std::cout << "  decoded " << decoded << " of " << bodies.size() << " events!" << std::endl;
+    }
+
+    std::cout << std::setw(6) << batch << std::setw(10) << frames << std::setw(12) << wireBytes / 1024
+              << std::setw(14) << std::fixed << std::setprecision(1) << static_cast<double>(wireBytes) / bodies.size()
+              << std::setw(12) << static_cast<uint64_t>(frames / seconds)
+              << std::setw(12) << static_cast<uint64_t>(bodies.size() / seconds) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int total = argc > 1 ? std::atoi(argv[1]) : 50000;
+    std::vector<std::string> bodies;
+    bodies.reserve(total);
+    for (int i = 0; i < total; i++) {
+        bodies.push_back(eventBody(i));
+    }
+
+    std::cout << "=== Batched report benchmark: " << total << " events, loopback sink parsing every frame ===" << std::endl;
+    std::cout << std::setw(6) << "batch" << std::setw(10) << "frames" << std::setw(12) << "wire KB"
+              << std::setw(14) << "bytes/event" << std::setw(12) << "frames/s" << std::setw(12) << "events/s"
+              << std::endl;
+    size_t batches[] = {1, 4, 16, 64};
+    for (size_t batch : batches) {
+        runCase(bodies, batch);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "../client/include/SubscriptionMonitor.h"
+#include "../client/include/InboundDispatcher.h"
+#include "../client/include/Frame.h"
+
+// Per-MESSAGE routing cost as the number of subscriptions grows, and what building the
+// pipelined SUBSCRIBE batch of a bulk join costs. Routing replays receiveFrames: the
+// subscription header resolved through the id-indexed table to the dispatcher channel
+// cached on join, then dispatched inline, so only routing is timed.
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+static void runCase(int subscriptions, int messages) {
+    SubscriptionMonitor monitor;
+    size_t handled = 0;
+    InboundDispatcher dispatcher([&handled](const std::string&) { handled++; }, 0);
+    std::vector<Frame> batch;
+    batch.reserve(subscriptions);
+    Clock::time_point joinStart = Clock::now();
+    for (int id = 0; id < subscriptions; id++) {
+        std::string destination = "/game_" + std::to_string(id);
+        monitor.track(id, destination, dispatcher.channel(destination));
+        Frame frame("SUBSCRIBE");
+        frame.addHeader("destination", destination);
+        frame.addHeader("id", std::to_string(id));
+        batch.push_back(frame);
+    }
+    std::string wire;
+    for (const Frame& frame : batch) {
+        wire += frame.toString();
+        wire += '\0';
+    }
+    double joinUs = elapsedUs(joinStart);
+
+    // Spread over every subscription, so lookups don't stay in cache at 50k
+    std::vector<std::string> frames;
+    frames.reserve(messages);
+    for (int i = 0; i < messages; i++) {
+        int id = static_cast<int>((static_cast<long long>(i) * 7919) % subscriptions);
+        frames.push_back("MESSAGE\nsubscription:" + std::to_string(id) + "\nmessage-id:" + std::to_string(i) +
+                         "\ndestination:/game_" + std::to_string(id) + "\n\nuser: meni\n");
+    }
+
+    Clock::time_point routeStart = Clock::now();
+    for (std::string& frame : frames) {
+        uint64_t id;
+        InboundDispatcher::Channel* route =
+            Frame::peekNumber(frame, "subscription", id) ? monitor.route(id) : nullptr;
+        if (route != nullptr) {
+            dispatcher.dispatch(route, std::move(frame));
+        } else {
+            dispatcher.dispatch(Frame::peekHeader(frame, "destination"), std::move(frame));
+        }
+    }
+    double routeUs = elapsedUs(routeStart);
+
+    std::cout << subscriptions << " subscriptions: bulk join batch " << joinUs / 1000 << " ms ("
+              << wire.size() / 1024 << " KB), routing " << routeUs * 1000 / messages << " ns/message"
+              << (handled == frames.size() ? "" : " (frames lost!)") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int messages = argc > 1 ? std::atoi(argv[1]) : 500000;
+    std::cout << "=== Subscription scaling benchmark: bulk join and routing by subscription id ===" << std::endl;
+    for (int subscriptions : {10, 1000, 50000}) {
+        runCase(subscriptions, messages);
+    }
+    return 0;
+}
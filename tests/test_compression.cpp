@@ -0,0 +1,256 @@
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include <boost/asio.hpp>
+#include "../client/include/Lz4.h"
+#include "../client/include/FrameCompression.h"
+#include "../client/include/ConnectionHandler.h"
+#include "../client/include/Frame.h"
+
+using boost::asio::ip::tcp;
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+static std::string eventBody(int i) {
+    return "user: meni\nteam a: Germany\nteam b: Japan\nevent name: event " + std::to_string(i % 12) +
+           "\ntime: " + std::to_string(i) +
+           "\ngeneral game updates:\n\tactive: true\nteam a updates:\n\tpossession: 51%\nteam b updates:\n"
+           "\tpossession: 49%\ndescription:\nCommentary for event " + std::to_string(i) + ".\n";
+}
+
+static std::string randomBytes(size_t size, unsigned seed) {
+    std::mt19937 random(seed);
+    std::string bytes(size, '\0');
+    for (char& c : bytes) {
+        c = static_cast<char>(random() & 0xff);
+    }
+    return bytes;
+}
+
+static bool roundTrips(const std::string& input) {
+    std::string block;
+    Lz4::compress(input.data(), input.size(), block);
+    std::vector<char> output(input.size() + 1);
+    return block.size() <= Lz4::compressBound(input.size()) &&
+           Lz4::decompress(block.data(), block.size(), output.data(), input.size()) &&
+           std::string(output.data(), input.size()) == input;
+}
+
+void testLz4() {
+    std::cout << "\n=== Test: LZ4 Block Round Trip ===" << std::endl;
+
+    std::string report;
+    for (int i = 0; i < 40; i++) {
+        report += eventBody(i);
+    }
+    check(roundTrips("") && roundTrips("a") && roundTrips("hello hello hello"), "Short inputs");
+    check(roundTrips(std::string(100000, 'x')), "Long run, overlapping matches and long lengths");
+    check(roundTrips(randomBytes(70000, 1)), "Incompressible input");
+    check(roundTrips(report), "Report events");
+
+    std::string block;
+    Lz4::compress(report.data(), report.size(), block);
+    check(block.size() * 3 < report.size(), "Report events shrink to under a third");
+
+    // lz4.block.compress(b"hello hello hello hello", store_size=False) of the reference library
+    const std::string reference("\x68\x68\x65\x6c\x6c\x6f\x20\x06\x00\x50\x68\x65\x6c\x6c\x6f", 15);
+    char output[23];
+    check(Lz4::decompress(reference.data(), reference.size(), output, sizeof(output)) &&
+          std::string(output, sizeof(output)) == "hello hello hello hello", "Reads the reference library's blocks");
+}
+
+void testCorruptBlocks() {
+    std::cout << "\n=== Test: Corrupt Blocks Rejected ===" << std::endl;
+
+    std::string input = eventBody(1) + eventBody(2);
+    std::string block;
+    Lz4::compress(input.data(), input.size(), block);
+    std::vector<char> output(input.size());
+
+    check(Lz4::decompress(block.data(), block.size(), output.data(), input.size()), "Intact block accepted");
+    check(!Lz4::decompress(block.data(), block.size(), output.data(), input.size() - 1), "Output larger than claimed");
+    check(!Lz4::decompress(block.data(), block.size() - 3, output.data(), input.size()), "Truncated block");
+    check(!Lz4::decompress("\x10\x61\x05\x00", 4, output.data(), 10), "Offset before the start of the output");
+    check(!Lz4::decompress("\x10\x61\x00\x00", 4, output.data(), 10), "Zero offset");
+    check(!Lz4::decompress("", 0, output.data(), 0), "Empty block");
+
+    // Random damage must fail or decode, never read or write out of bounds
+    std::mt19937 random(7);
+    for (int i = 0; i < 2000; i++) {
+        std::string damaged = block;
+        damaged[random() % damaged.size()] ^= static_cast<char>(1 + random() % 255);
+        Lz4::decompress(damaged.data(), damaged.size(), output.data(), output.size());
+    }
+    check(true, "Randomly damaged blocks handled");
+}
+
+static Frame sendFrame(const std::string& body) {
+    Frame frame("SEND");
+    frame.addHeader("destination", "/Germany_Japan");
+    frame.setBody(body);
+    return frame;
+}
+
+// The MESSAGE a broker makes of a SEND, forwarding its headers
+static std::string messageOf(const Frame& send) {
+    return "MESSAGE\nsubscription:0\nmessage-id:7\n" + send.toString().substr(5);
+}
+
+void testFrameEncoding() {
+    std::cout << "\n=== Test: Frame Body Encoding ===" << std::endl;
+
+    FrameCompression compression;
+    std::string body;
+    for (int i = 0; i < 10; i++) {
+        body += eventBody(i);
+    }
+
+    Frame frame = sendFrame(body);
+    check(!compression.encode(frame) && frame.getBody() == body, "Off by default");
+
+    compression.setEnabled(true);
+    compression.setThreshold(body.size() + 1);
+    check(!compression.encode(frame) && !frame.hasHeader("content-encoding"), "Below the threshold left plain");
+
+    compression.setThreshold(64);
+    Frame noise = sendFrame(randomBytes(4000, 3));
+    check(!compression.encode(noise) && !noise.hasHeader("content-encoding"), "Left plain when it doesn't pay");
+
+    check(compression.encode(frame), "Compressed");
+    check(frame.getHeader("content-encoding") == "lz4" &&
+          frame.getHeader("content-length") == std::to_string(frame.getBody().size()) &&
+          frame.getBody().size() < body.size() / 3, "content-encoding and content-length set");
+    check(frame.getBody().compare(0, 4, std::string("\0\0\0\0", 4)) != 0 &&
+          static_cast<unsigned char>(frame.getBody()[0]) == (body.size() & 0xff), "Size prefix, little endian");
+
+    std::string decoded;
+    check(compression.decode(messageOf(frame), decoded) == FrameCompression::Result::DECODED, "Decoded");
+    check(decoded == messageOf(sendFrame(body)), "Same frame as sent plain, encoding headers dropped");
+
+    std::string plain = messageOf(sendFrame(body));
+    check(compression.decode(plain, decoded) == FrameCompression::Result::PLAIN, "Plain frame passed through");
+
+    Frame gzip = sendFrame("abc");
+    gzip.addHeader("content-encoding", "gzip");
+    check(compression.decode(messageOf(gzip), decoded) == FrameCompression::Result::FAILED, "Unknown encoding");
+
+    std::string corrupt = messageOf(frame);
+    corrupt.resize(corrupt.size() - 10);
+    check(compression.decode(corrupt, decoded) == FrameCompression::Result::FAILED, "Truncated body");
+
+    std::string huge = "MESSAGE\ncontent-encoding:lz4\n\n" + std::string("\xff\xff\xff\x7f\x10\x61", 6);
+    check(compression.decode(huge, decoded) == FrameCompression::Result::FAILED, "Oversized claim rejected");
+
+    std::ostringstream stats;
+    compression.printStats(stats);
+    check(stats.str().find("sent 1 of 2 bodies compressed") != std::string::npos &&
+          stats.str().find("received 1 compressed") != std::string::npos &&
+          stats.str().find("3 failed") != std::string::npos, "Stats count both directions");
+}
+
+void testContentLengthFraming() {
+    std::cout << "\n=== Test: content-length Framing ===" << std::endl;
+
+    FrameCompression compression;
+    compression.setEnabled(true);
+    compression.setThreshold(0);
+    std::string body;
+    for (int i = 0; i < 10; i++) {
+        body += eventBody(i);
+    }
+    Frame frame = sendFrame(body);
+    compression.encode(frame);
+    std::string encoded = messageOf(frame);
+    std::string plain = messageOf(sendFrame("user: meni\n"));
+    check(encoded.find('\0') != std::string::npos, "Compressed frame holds NULs");
+
+    boost::asio::io_service io;
+    // ConnectionHandler takes a short, so not an ephemeral port
+    const short port = 17780;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port));
+    std::thread server([&]() {
+        tcp::socket socket(io);
+        acceptor.accept(socket);
+        std::string wire = encoded + '\0' + "\n" + plain + '\0';
+        // In pieces, so a frame is split inside its body and right before its NULL
+        size_t cuts[] = {10, encoded.size() - 20, encoded.size(), wire.size()};
+        size_t sent = 0;
+        for (size_t cut : cuts) {
+            boost::asio::write(socket, boost::asio::buffer(wire.data() + sent, cut - sent));
+            sent = cut;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    });
+
+    ConnectionHandler handler("127.0.0.1", port);
+    std::vector<std::string> frames;
+    bool connected = handler.connect();
+    while (connected && frames.size() < 2 && handler.getFrames(frames, '\0')) {
+    }
+    server.join();
+
+    check(frames.size() == 2, "Both frames taken");
+    check(frames.size() == 2 && frames[0] == encoded, "Binary body kept whole, NULs included");
+    check(frames.size() == 2 && frames[1] == plain, "Next frame found after the body");
+}
+
+void testContentLengthMismatch() {
+    std::cout << "\n=== Test: content-length Without Its NULL ===" << std::endl;
+
+    std::string good = messageOf(sendFrame("user: meni\n"));
+    // Claims 3 body bytes, but the NULL comes later: the rest would be misread as frames
+    std::string bad = "MESSAGE\ncontent-length:3\n\nabcdef";
+
+    boost::asio::io_service io;
+    const short port = 17781;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port));
+    std::thread server([&]() {
+        tcp::socket socket(io);
+        acceptor.accept(socket);
+        std::string wire = good + '\0' + bad + '\0' + good + '\0';
+        boost::asio::write(socket, boost::asio::buffer(wire));
+        // Held open: only the client may end the connection
+        char byte;
+        boost::system::error_code error;
+        socket.read_some(boost::asio::buffer(&byte, 1), error);
+    });
+
+    ConnectionHandler handler("127.0.0.1", port);
+    std::vector<std::string> frames;
+    std::vector<std::string> batch;
+    bool connected = handler.connect();
+    while (connected && handler.getFrames(batch, '\0')) {
+        frames.insert(frames.end(), batch.begin(), batch.end());
+        batch.clear();
+    }
+    server.join();
+
+    check(frames.size() == 1 && frames[0] == good, "Frame before the bad one delivered");
+    check(connected, "Bad body fails the connection, nothing after it taken");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Compression Tests                                   ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testLz4();
+    testCorruptBlocks();
+    testFrameEncoding();
+    testContentLengthFraming();
+    testContentLengthMismatch();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL COMPRESSION TESTS PASSED!                    ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
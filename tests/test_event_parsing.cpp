@@ -88,6 +88,86 @@ void testEventConstructorFromFrameBody() {
     std::cout << "✅ PASSED: Event parsing from frame body works!" << std::endl;
 }
 
+void testEventBatch() {
+    std::cout << "\n=== Test: Multi-Event Bodies ===" << std::endl;
+    
+    std::string first = "user: john\nteam a: USA\nteam b: Mexico\nevent name: kickoff\ntime: 0\n"
+                        "general game updates:\nteam a updates:\nteam b updates:\ndescription:\nStart\n";
+    std::string second = "user: john\nteam a: USA\nteam b: Mexico\nevent name: goal\ntime: 60\n"
+                         "general game updates:\nteam a updates:\ngoals:1\nteam b updates:\ndescription:\nGoal\n";
+    std::string body = first + EVENT_SEPARATOR + second;
+    
+    // Each range parsed on its own, as handleMessage does
+    std::vector<Event> events;
+    for (const auto& range : splitEventBatch(body, 0)) {
+        events.emplace_back(body.substr(range.first, range.second - range.first));
+    }
+    assert(events.size() == 2);
+    assert(events[0].get_name() == "kickoff" && events[1].get_name() == "goal");
+    assert(events[1].get_time() == 60 && events[1].get_team_a_updates().at("goals") == "1");
+    assert(events[0].get_discription().find("Goal") == std::string::npos);
+    std::cout << "✅ Both events parsed, nothing leaking across the separator" << std::endl;
+    
+    // Ranges index the text they were found in, e.g. a raw frame past its headers
+    std::string frame = "MESSAGE\nevent-count:2\n\n" + body;
+    size_t bodyStart = frame.find("\n\n") + 2;
+    std::vector<std::pair<size_t, size_t>> ranges = splitEventBatch(frame, bodyStart);
+    assert(ranges.size() == 2);
+    assert(frame.substr(ranges[0].first, ranges[0].second - ranges[0].first) == first);
+    assert(frame.substr(ranges[1].first, ranges[1].second - ranges[1].first) == second);
+    std::cout << "✅ Ranges split a raw frame in place" << std::endl;
+    
+    ranges = splitEventBatch(first, 0);
+    assert(ranges.size() == 1 && ranges[0] == std::make_pair(static_cast<size_t>(0), first.size()));
+    std::cout << "✅ A plain body is one event" << std::endl;
+    
+    std::cout << "✅ PASSED: Multi-event bodies split transparently!" << std::endl;
+}
+
+void testJsonLines() {
+    std::cout << "\n=== Test: JSON Lines Parsing ===" << std::endl;
+    
+    std::string team_a;
+    std::string team_b;
+    parseEventsHeaderLine("{\"team a\": \"USA\", \"team b\": \"Mexico\"}", team_a, team_b);
+    assert(team_a == "USA" && team_b == "Mexico");
+    std::cout << "✅ Header line parsed" << std::endl;
+    
+    Event event = parseEventLine("{\"event name\": \"goal\", \"time\": 60, \"general game updates\": {\"active\": true}, "
+                                 "\"team a updates\": {\"goals\": \"1\"}, \"team b updates\": {}, \"description\": \"Goal\"}",
+                                 team_a, team_b);
+    assert(event.get_name() == "goal" && event.get_time() == 60);
+    assert(event.get_team_a_name() == "USA" && event.get_team_b_name() == "Mexico");
+    assert(event.get_game_updates().at("active") == "true" && event.get_team_a_updates().at("goals") == "1");
+    std::cout << "✅ Event line parsed, non-string updates kept as JSON text" << std::endl;
+    
+    const char* badHeaders[] = {"", "{\"team a\": \"USA\"", "{\"team a\": \"USA\"}", "[1, 2]"};
+    for (const char* line : badHeaders) {
+        bool threw = false;
+        try {
+            parseEventsHeaderLine(line, team_a, team_b);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "✅ Bad header lines throw (empty, cut short, missing team, not an object)" << std::endl;
+    
+    const char* badEvents[] = {"not json", "{\"event name\": \"goal\"}", "{\"event name\": 5, \"time\": 1}", "\"goal\""};
+    for (const char* line : badEvents) {
+        bool threw = false;
+        try {
+            parseEventLine(line, team_a, team_b);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "✅ Bad event lines throw (not JSON, missing fields, wrong types, not an object)" << std::endl;
+    
+    std::cout << "✅ PASSED: JSON Lines parsing works!" << std::endl;
+}
+
 int main() {
     std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║  Event Parsing Tests                                 ║" << std::endl;
@@ -96,6 +176,8 @@ int main() {
     try {
         testJSONParsing();
         testEventConstructorFromFrameBody();
+        testEventBatch();
+        testJsonLines();
         
         std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
         std::cout << "║  ✅ ALL EVENT TESTS PASSED!                          ║" << std::endl;
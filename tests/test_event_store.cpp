@@ -0,0 +1,409 @@
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "../client/include/ShardedEventStore.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+Event makeEvent(const std::string& name, int time, const std::string& goals_a, const std::string& description) {
+    std::map<std::string, std::string> general;
+    std::map<std::string, std::string> team_a;
+    std::map<std::string, std::string> team_b;
+    general["active"] = "true";
+    if (!goals_a.empty()) team_a["goals"] = goals_a;
+    return Event("Germany", "Japan", name, time, general, team_a, team_b, description);
+}
+
+void testSummaryFormat() {
+    std::cout << "\n=== Test: Summary Format ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("kickoff", 0, "", "The game has started!"));
+    store.add("Germany_Japan", "meni", makeEvent("goal!!!!", 1980, "1", "Germany lead!"));
+
+    std::string summary;
+    check(store.summarize("Germany_Japan", "meni", summary), "Summary rendered");
+
+    std::string expected =
+        "Germany vs Japan\n"
+        "Game stats:\n"
+        "General stats:\n"
+        "active: true\n"
+        "Germany stats:\n"
+        "goals: 1\n"
+        "Japan stats:\n"
+        "Game event reports:\n"
+        "0 - kickoff:\n\n"
+        "The game has started!\n\n\n"
+        "1980 - goal!!!!:\n\n"
+        "Germany lead!\n\n\n";
+    check(summary == expected, "Summary matches the report format");
+}
+
+void testLookups() {
+    std::cout << "\n=== Test: Game and User Lookups ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("kickoff", 0, "", "start"));
+
+    std::string summary;
+    check(store.hasGame("Germany_Japan") && !store.hasGame("Spain_Japan"), "Known and unknown games");
+    check(store.hasStream("Germany_Japan", "meni") && !store.hasStream("Germany_Japan", "dana"), "Known and unknown users");
+    check(!store.summarize("Germany_Japan", "dana", summary), "No summary for unknown user");
+    check(store.eventCount() == 1, "Event count");
+}
+
+void testEventsSortedByTime() {
+    std::cout << "\n=== Test: Events Sorted By Time ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("second", 60, "", "b"));
+    store.add("Germany_Japan", "meni", makeEvent("first", 10, "", "a"));
+    store.add("Germany_Japan", "meni", makeEvent("third", 60, "", "c"));
+
+    std::string summary;
+    store.summarize("Germany_Japan", "meni", summary);
+    size_t first = summary.find("10 - first");
+    size_t second = summary.find("60 - second");
+    size_t third = summary.find("60 - third");
+    check(first < second && second < third, "Chronological, ties in arrival order");
+}
+
+void testLateEventDoesNotOverrideStats() {
+    std::cout << "\n=== Test: Late Event Keeps Newer Stats ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("goal", 100, "2", "second goal"));
+    store.add("Germany_Japan", "meni", makeEvent("goal", 50, "1", "first goal, reported late"));
+
+    std::string summary;
+    store.summarize("Germany_Japan", "meni", summary);
+    check(summary.find("goals: 2\n") != std::string::npos, "Stat keeps the value with the greater time");
+    check(summary.find("50 - goal") < summary.find("100 - goal"), "Late event placed by its time");
+
+    store.add("Germany_Japan", "meni", makeEvent("goal", 100, "3", "correction"));
+    store.summarize("Germany_Japan", "meni", summary);
+    check(summary.find("goals: 3\n") != std::string::npos, "Equal times resolve in arrival order");
+}
+
+void testSummaryAtTime() {
+    std::cout << "\n=== Test: Point-In-Time Summary ===" << std::endl;
+
+    GameEventStore store;
+    store.setCheckpointInterval(4);
+    for (int i = 0; i < 20; i++) {
+        // Every fifth event arrives after the one following it
+        int time = (i % 5 == 4) ? i * 10 - 15 : i * 10;
+        store.add("Germany_Japan", "meni", makeEvent("e" + std::to_string(i), time, std::to_string(i), "d"));
+    }
+
+    // The reference: a store holding only the events up to the point in time
+    for (int at : {-1, 0, 35, 60, 95, 190, 1000}) {
+        GameEventStore reference;
+        reference.setCheckpointInterval(0);
+        for (int i = 0; i < 20; i++) {
+            int time = (i % 5 == 4) ? i * 10 - 15 : i * 10;
+            if (time <= at) {
+                reference.add("Germany_Japan", "meni", makeEvent("e" + std::to_string(i), time, std::to_string(i), "d"));
+            }
+        }
+        std::string expected;
+        reference.summarize("Germany_Japan", "meni", expected);
+        std::string summary;
+        store.summarizeAt("Germany_Japan", "meni", at, summary);
+        if (expected.empty()) {
+            const std::string tail = "Game event reports:\n";
+            check(summary.compare(summary.size() - tail.size(), tail.size(), tail) == 0,
+                  "No events before " + std::to_string(at));
+        } else {
+            check(summary == expected, "Summary as of " + std::to_string(at));
+        }
+    }
+
+    std::string withCheckpoints;
+    std::string withoutCheckpoints;
+    store.setCheckpointInterval(3);
+    store.summarizeAt("Germany_Japan", "meni", 95, withCheckpoints);
+    store.setCheckpointInterval(0);
+    store.summarizeAt("Germany_Japan", "meni", 95, withoutCheckpoints);
+    check(withCheckpoints == withoutCheckpoints && store.checkpointMemoryBytes() == 0,
+          "Changing the interval rebuilds checkpoints");
+}
+
+void testQuery() {
+    std::cout << "\n=== Test: Range And Attribute Queries ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("kickoff", 0, "", "start"));
+    store.add("Germany_Japan", "meni", makeEvent("goal!!!!", 1980, "1", "first"));
+    store.add("Germany_Japan", "meni", makeEvent("halftime", 2700, "", "break"));
+    store.add("Germany_Japan", "dana", makeEvent("goal!!!!", 1975, "1", "first, seen by dana"));
+    store.add("Germany_Japan", "meni", makeEvent("goal!!!!", 1000, "0", "disallowed, reported late"));
+
+    EventQuery q;
+    q.game = "Germany_Japan";
+    q.user = "meni";
+    q.from = 1000;
+    q.to = 2700;
+    std::string out;
+    size_t matches = 0;
+    check(store.query(q, out, matches) && matches == 3, "Inclusive time range");
+    check(out.find("1000 - goal!!!! (meni)") < out.find("1980 - goal!!!! (meni)"), "Results ordered by time");
+
+    q.to = 2000;
+    q.eventName = "goal!!!!";
+    store.query(q, out, matches);
+    check(matches == 2 && out.find("halftime") == std::string::npos, "Filter by event name");
+
+    q.eventName = "";
+    q.statKey = "goals";
+    q.from = 1500;
+    store.query(q, out, matches);
+    check(matches == 1 && out.find("Germany goals: 1\n") != std::string::npos, "Filter by stat key shows its value");
+
+    q.user = "";
+    store.query(q, out, matches);
+    check(matches == 2 && out.find("1975 - goal!!!! (dana)") < out.find("1980 - goal!!!! (meni)"),
+          "All users merged by time");
+
+    q.statKey = "unknown stat";
+    check(store.query(q, out, matches) && matches == 0 && out.empty(), "Unknown stat matches nothing");
+
+    q.user = "ron";
+    check(!store.query(q, out, matches), "Unknown user");
+
+    EventQuery all;
+    all.game = "Germany_Japan";
+    check(store.query(all, out, matches) && matches == 5, "Default query spans all times and users");
+}
+
+void testSearch() {
+    std::cout << "\n=== Test: Description Search ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("goal!!!!", 1980, "1", "Gundogan slotted it home"));
+    store.add("Germany_Japan", "dana", makeEvent("offside", 600, "", "Maeda tapped in but was offside"));
+    store.add("Spain_Japan", "meni", makeEvent("goal!!!!", 700, "", "Morata heads home"));
+
+    std::string out;
+    size_t matches = 0;
+    check(store.search("Germany_Japan", {"home"}, false, out, matches) && matches == 1 &&
+          out == "Germany_Japan 1980 - goal!!!! (meni)\n", "Search one game");
+
+    store.search("*", {"home"}, false, out, matches);
+    check(matches == 2 && out.find("Germany_Japan") < out.find("Spain_Japan"), "Search every game");
+
+    store.search("Germany_Japan", {"maeda", "gundogan"}, true, out, matches);
+    check(matches == 2 && out.find("600 - offside (dana)") < out.find("1980 - goal"), "OR results by time");
+
+    check(!store.search("France_Japan", {"home"}, false, out, matches), "Unknown game");
+}
+
+void testMergedSummary() {
+    std::cout << "\n=== Test: Merged Multi-User Summary ===" << std::endl;
+
+    GameEventStore store;
+    store.add("Germany_Japan", "meni", makeEvent("kickoff", 0, "", "start"));
+    store.add("Germany_Japan", "meni", makeEvent("goal!!!!", 1980, "1", "Germany lead!"));
+    store.add("Germany_Japan", "dana", makeEvent("kickoff", 0, "", "start"));
+    store.add("Germany_Japan", "dana", makeEvent("chance", 1000, "", "Close!"));
+    store.add("Germany_Japan", "dana", makeEvent("goal!!!!", 2200, "2", "Germany double it"));
+    store.add("Germany_Japan", "ron", makeEvent("kickoff", 0, "", "And we're off"));
+
+    std::ostringstream out;
+    size_t duplicates = 0;
+    check(store.summarizeMerged("Germany_Japan", std::numeric_limits<int>::max(), out, duplicates),
+          "Merged summary rendered");
+    std::string summary = out.str();
+    check(duplicates == 1, "Identical report from two users collapsed");
+    check(summary.find("0 - kickoff:\n\nAnd we're off") != std::string::npos &&
+          summary.find("0 - kickoff:\n\nstart") != std::string::npos, "Different descriptions both kept");
+    size_t chance = summary.find("1000 - chance");
+    size_t lead = summary.find("1980 - goal!!!!");
+    size_t doubled = summary.find("2200 - goal!!!!");
+    check(chance < lead && lead < doubled && doubled != std::string::npos, "Users' streams merged by time");
+    check(summary.find("goals: 2\n") != std::string::npos, "Stats take the latest value across users");
+
+    std::ostringstream early;
+    store.summarizeMerged("Germany_Japan", 1500, early, duplicates);
+    check(early.str().find("goals:") == std::string::npos && early.str().find("1000 - chance") != std::string::npos,
+          "Merged summary as of a time");
+}
+
+void testShardedStore() {
+    std::cout << "\n=== Test: Sharded Store Under Concurrent Ingest ===" << std::endl;
+
+    ShardedEventStore store;
+    check(!store.read("Germany_Japan", [](const GameEventStore&) {}), "Unknown game is not read");
+
+    // Two ingest threads on different games while a reader keeps summarizing one of them
+    const int perThread = 3000;
+    std::thread germany([&]() {
+        for (int i = 0; i < perThread; i++) store.add("Germany_Japan", "meni", makeEvent("e", i, "", "d"));
+    });
+    std::thread spain([&]() {
+        for (int i = 0; i < perThread; i++) store.add("Spain_Japan", "dana", makeEvent("e", i, "", "d"));
+    });
+    size_t lastSeen = 0;
+    bool monotonic = true;
+    for (int r = 0; r < 50; r++) {
+        store.read("Germany_Japan", [&](const GameEventStore& s) {
+            monotonic = monotonic && s.eventCount() >= lastSeen;
+            lastSeen = s.eventCount();
+        });
+    }
+    germany.join();
+    spain.join();
+    check(monotonic, "Readers see a growing store");
+
+    size_t total = 0;
+    std::vector<std::string> games;
+    store.readAll([&](const std::string& game, const GameEventStore& s) {
+        games.push_back(game);
+        total += s.eventCount();
+    });
+    check(total == 2 * perThread, "Every event is visible to readers, pending ones included");
+    check(games.size() == 2 && games[0] == "Germany_Japan" && games[1] == "Spain_Japan", "Games read in name order");
+}
+
+void testReaderSnapshot() {
+    std::cout << "\n=== Test: Readers Hold No Lock ===" << std::endl;
+
+    ShardedEventStore store;
+    GameEventStore reference;
+    auto add = [&](const std::string& user, int i) {
+        Event event = makeEvent("e" + std::to_string(i % 3), i, std::to_string(i / 10), "Play " + std::to_string(i));
+        store.add("Germany_Japan", user, event);
+        reference.add("Germany_Japan", user, event);
+    };
+    for (int i = 0; i < 10; i++) {
+        add(i % 2 ? "meni" : "dana", i);
+    }
+
+    // A reader parked inside read(), as a summary stuck on a slow file write would be
+    std::atomic<bool> entered(false);
+    std::atomic<bool> release(false);
+    size_t before = 0;
+    size_t after = 0;
+    std::thread slow([&]() {
+        store.read("Germany_Japan", [&](const GameEventStore& s) {
+            before = s.eventCount();
+            entered = true;
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            after = s.eventCount();
+        });
+    });
+    while (!entered) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Enough events for add() to fold on its own
+    for (int i = 10; i < 2010; i++) {
+        add(i % 2 ? "meni" : "dana", i);
+    }
+    std::ostringstream stats;
+    store.printStats(stats);
+    check(stats.str().find("pending: 2000 events") == std::string::npos, "Events folded while a reader holds the store");
+
+    std::atomic<bool> done(false);
+    std::string summary;
+    std::string found;
+    size_t matches = 0;
+    std::thread second([&]() {
+        store.read("Germany_Japan", [&](const GameEventStore& s) {
+            s.summarize("Germany_Japan", "meni", summary);
+            s.search("Germany_Japan", std::vector<std::string>(1, "play"), false, found, matches);
+        });
+        done = true;
+    });
+    for (int i = 0; i < 100 && !done; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool finished = done;
+    release = true;
+    slow.join();
+    second.join();
+    check(finished, "A second reader isn't held up by the first");
+    check(before == 10 && after == 10, "The first reader's snapshot never changes");
+
+    std::string expectedSummary;
+    std::string expectedFound;
+    size_t expectedMatches = 0;
+    reference.summarize("Germany_Japan", "meni", expectedSummary);
+    reference.search("Germany_Japan", std::vector<std::string>(1, "play"), false, expectedFound, expectedMatches);
+    check(summary == expectedSummary, "Copied store summarizes like the original");
+    check(matches == 2010 && found == expectedFound, "Copied store's search index points at its own streams");
+}
+
+void testLazyDecoding() {
+    std::cout << "\n=== Test: Raw Events Decoded On Read ===" << std::endl;
+
+    ShardedEventStore eager;
+    ShardedEventStore lazy;
+    bool routed = true;
+    for (int i = 0; i < 20; i++) {
+        std::string goals = std::to_string(i / 5);
+        std::string description = "Play number " + std::to_string(i) + "\nsecond line";
+        std::string body = "user: meni\nteam a: Germany\nteam b: Japan\nevent name: e" + std::to_string(i % 3) +
+                           "\ntime: " + std::to_string(100 - i) + "\ngeneral game updates:\nactive:true\n"
+                           "team a updates:\ngoals:" + goals + "\nteam b updates:\ndescription:\n" + description;
+
+        std::string user;
+        std::string team_a;
+        std::string team_b;
+        peekEventRouting(body, 0, user, team_a, team_b);
+        routed = routed && user == "meni" && team_a == "Germany" && team_b == "Japan";
+        lazy.addRaw(team_a + "_" + team_b, user, body.data(), body.size());
+        eager.add("Germany_Japan", "meni", Event(body));
+    }
+    check(routed, "Routing fields peeked without decoding");
+
+    std::ostringstream stats;
+    lazy.printStats(stats);
+    check(stats.str().find("pending: 20 events (20 undecoded)") != std::string::npos, "Stats leave raw events undecoded");
+
+    std::string lazySummary;
+    std::string eagerSummary;
+    lazy.read("Germany_Japan", [&](const GameEventStore& s) { s.summarize("Germany_Japan", "meni", lazySummary); });
+    eager.read("Germany_Japan", [&](const GameEventStore& s) { s.summarize("Germany_Japan", "meni", eagerSummary); });
+    check(!lazySummary.empty() && lazySummary == eagerSummary, "Decoded on read, same summary as eager decoding");
+
+    stats.str("");
+    lazy.printStats(stats);
+    check(stats.str().find("pending: 0 events (0 undecoded)") != std::string::npos, "Nothing left undecoded after a read");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Event Store Tests                                   ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testSummaryFormat();
+    testLookups();
+    testEventsSortedByTime();
+    testLateEventDoesNotOverrideStats();
+    testSummaryAtTime();
+    testQuery();
+    testSearch();
+    testMergedSummary();
+    testShardedStore();
+    testReaderSnapshot();
+    testLazyDecoding();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL EVENT STORE TESTS PASSED!                    ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -178,6 +178,32 @@ void testFrameParsing() {
     assertStringContains(body, "team a: USA", "Body contains team info");
 }
 
+void testFramePeek() {
+    std::cout << "\n=== Test 7: Peeking Command And Headers ===" << std::endl;
+    
+    std::string rawFrame = "MESSAGE\n"
+                          "subscription:17\n"
+                          "destination:/usa_mexico\n"
+                          "\n"
+                          "destination:/not_a_header\n";
+    
+    assert(Frame::peekCommand(rawFrame) == "MESSAGE");
+    std::cout << "✅ PASSED: Peeked command" << std::endl;
+    
+    assert(Frame::peekHeader(rawFrame, "destination") == "/usa_mexico");
+    std::cout << "✅ PASSED: Peeked destination header" << std::endl;
+    
+    assert(Frame::peekHeader(rawFrame, "receipt-id") == "");
+    assert(Frame::peekHeader(rawFrame, "subscriptio") == "");
+    std::cout << "✅ PASSED: Missing header and key prefixes don't match" << std::endl;
+    
+    uint64_t value = 0;
+    assert(Frame::peekNumber(rawFrame, "subscription", value) && value == 17);
+    assert(!Frame::peekNumber(rawFrame, "destination", value) && value == 17);
+    assert(!Frame::peekNumber(rawFrame, "message-id", value));
+    std::cout << "✅ PASSED: Peeked numeric header, non-numbers rejected" << std::endl;
+}
+
 int main() {
     std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║  STOMP Frame Format Tests - PDF Compliance Check    ║" << std::endl;
@@ -190,6 +216,7 @@ int main() {
         testSendFrameWithBody();
         testDisconnectFrame();
         testFrameParsing();
+        testFramePeek();
         
         std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
         std::cout << "║  ✅ ALL TESTS PASSED!                                ║" << std::endl;
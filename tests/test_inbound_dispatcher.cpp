@@ -0,0 +1,223 @@
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <map>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <condition_variable>
+#include "../client/include/InboundDispatcher.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+// Frames are "<key>:<sequence>"; the handler records each key's sequences in handling order
+struct Recorder {
+    std::mutex mtx;
+    std::map<std::string, std::vector<int>> byKey;
+    std::map<std::string, std::thread::id> threadOf;
+    bool sameThreadPerKey = true;
+
+    void handle(const std::string& frame) {
+        size_t colon = frame.find(':');
+        std::string key = frame.substr(0, colon);
+        std::lock_guard<std::mutex> lock(mtx);
+        byKey[key].push_back(std::stoi(frame.substr(colon + 1)));
+        auto it = threadOf.find(key);
+        if (it == threadOf.end()) {
+            threadOf[key] = std::this_thread::get_id();
+        } else if (it->second != std::this_thread::get_id()) {
+            sameThreadPerKey = false;
+        }
+    }
+};
+
+static bool inOrder(const std::vector<int>& sequences, int count) {
+    if (static_cast<int>(sequences.size()) != count) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        if (sequences[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testOrderingPerKey() {
+    std::cout << "\n=== Test: Per-Key Ordering Across Workers ===" << std::endl;
+
+    Recorder recorder;
+    InboundDispatcher dispatcher([&recorder](const std::string& frame) { recorder.handle(frame); }, 4);
+
+    const char* keys[] = {"/Germany_Japan", "/Spain_Morocco", "/Brazil_Serbia", "/France_Denmark", "/Qatar_Ecuador"};
+    const int perKey = 5000;
+    for (int i = 0; i < perKey; i++) {
+        for (const char* key : keys) {
+            dispatcher.dispatch(key, std::string(key) + ":" + std::to_string(i));
+        }
+    }
+    dispatcher.flush();
+
+    std::lock_guard<std::mutex> lock(recorder.mtx);
+    bool allInOrder = true;
+    for (const char* key : keys) {
+        allInOrder = allInOrder && inOrder(recorder.byKey[key], perKey);
+    }
+    check(allInOrder, "flush() waits for every frame, each key in dispatch order");
+    check(recorder.sameThreadPerKey, "Each key is handled by a single worker");
+    check(recorder.threadOf.size() == 5, "Every key was handled");
+}
+
+void testResizeKeepsFrames() {
+    std::cout << "\n=== Test: Resizing And Inline Mode ===" << std::endl;
+
+    Recorder recorder;
+    InboundDispatcher dispatcher([&recorder](const std::string& frame) { recorder.handle(frame); }, 2);
+
+    for (int i = 0; i < 1000; i++) {
+        dispatcher.dispatch("/a", "/a:" + std::to_string(i));
+    }
+    // Queued frames are handled before the old workers stop
+    dispatcher.setWorkers(3);
+    for (int i = 1000; i < 2000; i++) {
+        dispatcher.dispatch("/a", "/a:" + std::to_string(i));
+    }
+    dispatcher.flush();
+    {
+        std::lock_guard<std::mutex> lock(recorder.mtx);
+        check(inOrder(recorder.byKey["/a"], 2000), "No frame lost or reordered across setWorkers()");
+    }
+
+    dispatcher.setWorkers(0);
+    std::thread::id caller = std::this_thread::get_id();
+    dispatcher.dispatch("/b", "/b:0");
+    std::lock_guard<std::mutex> lock(recorder.mtx);
+    check(recorder.byKey["/b"].size() == 1 && recorder.threadOf["/b"] == caller,
+          "With 0 workers frames are handled inline");
+}
+
+// Dispatches frames 0..10 on one channel while the single worker is held inside frame 0,
+// so frames 1..10 meet a queue bounded at 3. Returns the frames handled; the ones shed
+// go to shed.
+static std::vector<int> runAgainstFullQueue(const std::string& policy, std::string& stats, std::vector<int>& shed) {
+    std::mutex gateMtx;
+    std::condition_variable gateCv;
+    bool entered = false;
+    bool open = false;
+    Recorder recorder;
+    Recorder dropped;
+    InboundDispatcher dispatcher([&](const std::string& frame) {
+        std::unique_lock<std::mutex> lock(gateMtx);
+        entered = true;
+        gateCv.notify_all();
+        gateCv.wait(lock, [&]() { return open; });
+        lock.unlock();
+        recorder.handle(frame);
+    }, 1, [&dropped](const std::string& frame) { dropped.handle(frame); });
+    dispatcher.setQueueLimit(3);
+    dispatcher.setPolicy(policy);
+
+    dispatcher.dispatch("/a", "/a:0");
+    {
+        std::unique_lock<std::mutex> lock(gateMtx);
+        gateCv.wait(lock, [&]() { return entered; });
+    }
+    for (int i = 1; i <= 10; i++) {
+        dispatcher.dispatch("/a", "/a:" + std::to_string(i));
+    }
+    {
+        std::lock_guard<std::mutex> lock(gateMtx);
+        open = true;
+    }
+    gateCv.notify_all();
+    dispatcher.flush();
+
+    std::ostringstream out;
+    dispatcher.printStats(out);
+    stats = out.str();
+    shed = dropped.byKey["/a"];
+    std::lock_guard<std::mutex> lock(recorder.mtx);
+    return recorder.byKey["/a"];
+}
+
+// Every frame 0..10 exactly once, either handled or shed
+static bool accountedFor(std::vector<int> handled, const std::vector<int>& shed) {
+    handled.insert(handled.end(), shed.begin(), shed.end());
+    std::sort(handled.begin(), handled.end());
+    return handled == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+}
+
+void testBoundedQueuePolicies() {
+    std::cout << "\n=== Test: Bounded Queue Policies ===" << std::endl;
+
+    std::string stats;
+    std::vector<int> shed;
+    std::vector<int> handled = runAgainstFullQueue("drop-newest", stats, shed);
+    check(handled == std::vector<int>({0, 1, 2, 3}), "drop-newest keeps the frames already queued");
+    check(stats.find("channel /a: received 11, dropped 7") != std::string::npos, "Drops counted per channel");
+    check(shed == std::vector<int>({4, 5, 6, 7, 8, 9, 10}), "drop-newest hands the new frames to the drop handler");
+    handled = runAgainstFullQueue("drop-oldest", stats, shed);
+    check(handled == std::vector<int>({0, 8, 9, 10}), "drop-oldest keeps the latest frames");
+    check(accountedFor(handled, shed), "drop-oldest hands the displaced frames to the drop handler");
+    // Over-budget frames 4..10; every second one (5, 7, 9) replaces the oldest queued frame
+    handled = runAgainstFullQueue("keep-every-2", stats, shed);
+    check(handled == std::vector<int>({0, 5, 7, 9}), "keep-every-2 samples the overflow");
+    check(accountedFor(handled, shed), "keep-every-2 hands both skipped and displaced frames to the drop handler");
+
+    bool rejected = false;
+    try {
+        InboundDispatcher dispatcher([](const std::string&) {}, 0);
+        dispatcher.setPolicy("drop-random");
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    check(rejected, "Unknown policy is rejected");
+}
+
+void testRateLimit() {
+    std::cout << "\n=== Test: Per-Channel Rate Limit ===" << std::endl;
+
+    Recorder recorder;
+    InboundDispatcher dispatcher([&recorder](const std::string& frame) { recorder.handle(frame); }, 0);
+    dispatcher.setRateLimit(5);
+    dispatcher.setPolicy("drop-newest");
+    for (int i = 0; i < 20; i++) {
+        dispatcher.dispatch("/a", "/a:" + std::to_string(i));
+        dispatcher.dispatch("/b", "/b:" + std::to_string(i));
+    }
+    check(recorder.byKey["/a"] == std::vector<int>({0, 1, 2, 3, 4}) && recorder.byKey["/b"].size() == 5,
+          "Each channel gets its own burst of one second's budget");
+
+    dispatcher.setRateLimit(5);   // refills the buckets
+    dispatcher.setPolicy("keep-every-3");
+    for (int i = 20; i < 40; i++) {
+        dispatcher.dispatch("/a", "/a:" + std::to_string(i));
+    }
+    // 20..24 within budget, then every third of the 15 over it
+    check(recorder.byKey["/a"].size() == 15 && recorder.byKey["/a"].back() == 39,
+          "keep-every-3 keeps a third of the frames over the rate");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Inbound Dispatcher Tests                            ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testOrderingPerKey();
+    testResizeKeepsFrames();
+    testBoundedQueuePolicies();
+    testRateLimit();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL DISPATCHER TESTS PASSED!                     ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cstdlib>
+#include <set>
+#include "../client/include/InvertedIndex.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+void testTokenize() {
+    std::cout << "\n=== Test: Tokenizer ===" << std::endl;
+
+    std::vector<std::string> words;
+    InvertedIndex::tokenize("Gündoğan slotted it home, 33rd-minute!", words);
+    check(words.size() == 6, "Splits on spaces and punctuation");
+    check(words[0] == "gündoğan", "Keeps UTF-8 names whole and lowercases ASCII");
+    check(words[4] == "33rd" && words[5] == "minute", "Digits are word characters");
+}
+
+void testAndOr() {
+    std::cout << "\n=== Test: AND / OR Search ===" << std::endl;
+
+    InvertedIndex index;
+    index.add(0, "The game has started");
+    index.add(1, "Havertz scores, the lead is doubled");
+    index.add(2, "Havertz was offside, the goal doesn't count");
+    index.add(3, "Asano scores for Japan");
+
+    std::vector<uint32_t> ids = index.search({"havertz", "offside"}, false);
+    check(ids.size() == 1 && ids[0] == 2, "AND of two terms");
+
+    ids = index.search({"SCORES"}, false);
+    check(ids == std::vector<uint32_t>({1, 3}), "Case-insensitive single term");
+
+    ids = index.search({"started", "asano"}, true);
+    check(ids == std::vector<uint32_t>({0, 3}), "OR of two terms");
+
+    check(index.search({"havertz", "musiala"}, false).empty(), "AND with an unknown term is empty");
+    check(index.search({"musiala"}, true).empty(), "OR of unknown terms is empty");
+
+    index.add(4, "the the the");
+    check(index.search({"the"}, false).size() == 4, "Terms repeated in one document are posted once");
+}
+
+void testLongListsMatchBruteForce() {
+    std::cout << "\n=== Test: Long Posting Lists ===" << std::endl;
+
+    // Lists long enough to use skips, with gaps wide enough for multi-byte deltas
+    InvertedIndex index;
+    std::set<uint32_t> twos, threes, sevens, rare;
+    for (uint32_t id = 0; id < 200000; id += (id % 1000 == 0) ? 300 : 1) {
+        std::string text = "event";
+        if (id % 2 == 0) { text += " two"; twos.insert(id); }
+        if (id % 3 == 0) { text += " three"; threes.insert(id); }
+        if (id % 7 == 0) { text += " seven"; sevens.insert(id); }
+        if (id % 9973 == 0) { text += " rare"; rare.insert(id); }
+        index.add(id, text);
+    }
+
+    auto expectedAnd = [](std::initializer_list<const std::set<uint32_t>*> sets) {
+        std::vector<uint32_t> result;
+        for (uint32_t id : **sets.begin()) {
+            bool all = true;
+            for (const std::set<uint32_t>* s : sets) all = all && s->count(id) > 0;
+            if (all) result.push_back(id);
+        }
+        return result;
+    };
+
+    check(index.search({"two", "three", "seven"}, false) == expectedAnd({&twos, &threes, &sevens}),
+          "Three-way AND matches brute force");
+    check(index.search({"rare", "two"}, false) == expectedAnd({&rare, &twos}),
+          "Short list driving a long one matches brute force");
+
+    std::set<uint32_t> either(sevens);
+    either.insert(rare.begin(), rare.end());
+    check(index.search({"seven", "rare"}, true) == std::vector<uint32_t>(either.begin(), either.end()),
+          "OR matches brute force");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Inverted Index Tests                                ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testTokenize();
+    testAndOr();
+    testLongListsMatchBruteForce();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL INVERTED INDEX TESTS PASSED!                 ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
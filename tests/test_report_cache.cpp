@@ -0,0 +1,206 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <dirent.h>
+#include "../client/include/ReportCache.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path);
+    out << content;
+}
+
+CachedReport makeReport(const std::string& team_a, const std::string& team_b, int events) {
+    CachedReport report;
+    report.team_a_name = team_a;
+    report.team_b_name = team_b;
+    for (int i = 0; i < events; i++) {
+        report.bodies.push_back("team a: " + team_a + "\nteam b: " + team_b + "\nevent name: e" + std::to_string(i) + "\n");
+    }
+    return report;
+}
+
+void testHitAndMiss() {
+    std::cout << "\n=== Test: Cache Hit / Miss ===" << std::endl;
+
+    std::string path = "test_report_cache_a.input";
+    writeFile(path, "{\"team a\": \"A\"}");
+
+    ReportCache cache;
+    ReportKey key;
+    check(ReportCache::makeKey(path, key), "Key built for existing file");
+
+    CachedReport out;
+    check(!cache.lookup(key, out), "First lookup misses");
+
+    cache.store(key, makeReport("A", "B", 3));
+    check(cache.lookup(key, out), "Second lookup hits");
+    check(out.bodies.size() == 3 && out.team_a_name == "A", "Hit returns stored bodies");
+
+    // Same size, different content: only the content hash tells them apart
+    writeFile(path, "{\"team a\": \"Z\"}");
+    ReportKey changed;
+    ReportCache::makeKey(path, changed);
+    check(!cache.lookup(changed, out), "Changed content misses");
+
+    ReportKey missing;
+    check(!ReportCache::makeKey("does_not_exist.input", missing), "Missing file has no key");
+
+    std::remove(path.c_str());
+}
+
+void testBudgetAndSpill() {
+    std::cout << "\n=== Test: Memory Budget and Spill ===" << std::endl;
+
+    std::string pathA = "test_report_cache_b.input";
+    std::string pathB = "test_report_cache_c.input";
+    writeFile(pathA, "first");
+    writeFile(pathB, "second");
+
+    ReportCache cache;
+    cache.setSpillDirectory(".");
+
+    ReportKey keyA, keyB;
+    ReportCache::makeKey(pathA, keyA);
+    ReportCache::makeKey(pathB, keyB);
+
+    CachedReport reportA = makeReport("A", "B", 10);
+    cache.setMemoryBudget(600);
+    cache.store(keyA, reportA);
+    cache.store(keyB, makeReport("C", "D", 10));
+
+    // Only one report fits: A was spilled to disk and is still served from there
+    CachedReport out;
+    check(cache.lookup(keyA, out), "Spilled entry hits");
+    check(out.bodies == reportA.bodies, "Spilled entry round-trips");
+
+    cache.setSpillDirectory("");
+    cache.setMemoryBudget(0);
+    check(!cache.lookup(keyA, out), "Evicted entry without spill misses");
+
+    std::remove(pathA.c_str());
+    std::remove(pathB.c_str());
+    std::system("rm -f ./*.rcache");
+}
+
+void testSpillIdentity() {
+    std::cout << "\n=== Test: Spill Files Per Path ===" << std::endl;
+
+    // Same contents, so the same content hash
+    std::string pathA = "test_report_cache_d.input";
+    std::string pathB = "test_report_cache_e.input";
+    std::string pathC = "test_report_cache_f.input";
+    writeFile(pathA, "same");
+    writeFile(pathB, "same");
+    writeFile(pathC, "other");
+
+    ReportCache cache;
+    cache.setSpillDirectory(".");
+    cache.setMemoryBudget(600);
+
+    ReportKey keyA, keyB, keyC;
+    ReportCache::makeKey(pathA, keyA);
+    ReportCache::makeKey(pathB, keyB);
+    ReportCache::makeKey(pathC, keyC);
+    check(keyA.hash == keyB.hash, "Equal files hash alike");
+
+    cache.store(keyA, makeReport("A", "B", 10));
+    cache.store(keyB, makeReport("C", "D", 10));
+    cache.store(keyC, makeReport("E", "F", 10));
+
+    // A and B are both spilled; neither overwrote nor deleted the other's file
+    CachedReport out;
+    check(cache.lookup(keyA, out) && out.team_a_name == "A", "First path reads its own spill");
+    check(cache.lookup(keyB, out) && out.team_a_name == "C", "Second path reads its own spill");
+
+    // A spilled, then stored again: the old spill must not come back
+    cache.store(keyC, makeReport("E", "F", 10));
+    cache.store(keyA, makeReport("G", "H", 10));
+    cache.setSpillDirectory("");
+    cache.setMemoryBudget(0);
+    check(!cache.lookup(keyA, out), "Stored entry replaces its old spill");
+
+    std::remove(pathA.c_str());
+    std::remove(pathB.c_str());
+    std::remove(pathC.c_str());
+    std::system("rm -f ./*.rcache");
+}
+
+// Spill files in the current directory
+static std::vector<std::string> spillFiles() {
+    std::vector<std::string> files;
+    DIR* dir = opendir(".");
+    for (dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > 7 && name.compare(name.size() - 7, 7, ".rcache") == 0) {
+            files.push_back(name);
+        }
+    }
+    closedir(dir);
+    return files;
+}
+
+void testCorruptSpill() {
+    std::cout << "\n=== Test: Corrupt Spill Files ===" << std::endl;
+
+    // A body length past the end of the file, a count no file could hold, a huge name length
+    const std::string corruptions[] = {"1\nA1\nB1\n100\nshort", "1\nA1\nB18446744073709551615\n",
+                                       "18446744073709551615\nA"};
+    for (const std::string& corruption : corruptions) {
+        std::string pathA = "test_report_cache_g.input";
+        std::string pathB = "test_report_cache_h.input";
+        writeFile(pathA, "first");
+        writeFile(pathB, "second");
+
+        ReportCache cache;
+        cache.setSpillDirectory(".");
+        cache.setMemoryBudget(600);
+        ReportKey keyA, keyB;
+        ReportCache::makeKey(pathA, keyA);
+        ReportCache::makeKey(pathB, keyB);
+        cache.store(keyA, makeReport("A", "B", 10));
+        cache.store(keyB, makeReport("C", "D", 10));
+
+        std::vector<std::string> files = spillFiles();
+        check(files.size() == 1, "First report spilled");
+        writeFile(files[0], corruption);
+
+        CachedReport out;
+        bool hit = true;
+        try {
+            hit = cache.lookup(keyA, out);
+        } catch (const std::exception& e) {
+            std::cerr << "lookup threw: " << e.what() << std::endl;
+        }
+        check(!hit, "Corrupt spill is a miss");
+        check(spillFiles().empty(), "Corrupt spill removed");
+
+        std::remove(pathA.c_str());
+        std::remove(pathB.c_str());
+    }
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Report Cache Tests                                  ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testHitAndMiss();
+    testBudgetAndSpill();
+    testSpillIdentity();
+    testCorruptSpill();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL REPORT CACHE TESTS PASSED!                   ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include "../client/include/ReportCheckpoints.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+void testRoundTrip() {
+    std::cout << "\n=== Test: Save / Load Round Trip ===" << std::endl;
+
+    std::string path = "test_report_checkpoints_a.txt";
+    std::remove(path.c_str());
+
+    {
+        ReportCheckpoints checkpoints;
+        checkpoints.setPath(path);
+        check(checkpoints.acknowledged("data/events1.json", 0xabc) == 0, "Unknown file starts at 0");
+        checkpoints.record("data/events1.json", 0xabc, 50);
+        checkpoints.record("data/with space.json", 0xdef, 7);
+    }
+
+    // A fresh instance, as after a restart of the client
+    ReportCheckpoints reloaded;
+    reloaded.setPath(path);
+    check(reloaded.acknowledged("data/events1.json", 0xabc) == 50, "Checkpoint read back");
+    check(reloaded.acknowledged("data/with space.json", 0xdef) == 7, "Path with a space read back");
+
+    std::ifstream tmp(path + ".tmp");
+    check(!tmp.is_open(), "Temporary file renamed into place");
+
+    std::remove(path.c_str());
+}
+
+void testChangedFile() {
+    std::cout << "\n=== Test: Changed File Starts Over ===" << std::endl;
+
+    std::string path = "test_report_checkpoints_b.txt";
+    std::remove(path.c_str());
+
+    ReportCheckpoints checkpoints;
+    checkpoints.setPath(path);
+    checkpoints.record("report.json", 0x111, 40);
+    check(checkpoints.acknowledged("report.json", 0x222) == 0, "Other content hash resets to 0");
+
+    // The new content's progress replaces the old, even though it is smaller
+    checkpoints.record("report.json", 0x222, 10);
+    ReportCheckpoints reloaded;
+    reloaded.setPath(path);
+    check(reloaded.acknowledged("report.json", 0x222) == 10, "New content recorded");
+    check(reloaded.acknowledged("report.json", 0x111) == 0, "Old content forgotten");
+
+    std::remove(path.c_str());
+}
+
+void testNeverBackwards() {
+    std::cout << "\n=== Test: Record Never Moves Backwards ===" << std::endl;
+
+    std::string path = "test_report_checkpoints_c.txt";
+    std::remove(path.c_str());
+
+    ReportCheckpoints checkpoints;
+    checkpoints.setPath(path);
+    checkpoints.record("report.json", 0x333, 100);
+    // Receipts can be handled out of order
+    checkpoints.record("report.json", 0x333, 50);
+    check(checkpoints.acknowledged("report.json", 0x333) == 100, "Lower count ignored");
+
+    ReportCheckpoints reloaded;
+    reloaded.setPath(path);
+    check(reloaded.acknowledged("report.json", 0x333) == 100, "Lower count not saved either");
+
+    checkpoints.record("report.json", 0x333, 150);
+    check(checkpoints.acknowledged("report.json", 0x333) == 150, "Higher count recorded");
+
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Report Checkpoint Tests                             ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testRoundTrip();
+    testChangedFile();
+    testNeverBackwards();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL REPORT CHECKPOINT TESTS PASSED!              ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "../client/include/ReportFollower.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+static std::string eventLine(const std::string& name, int time) {
+    return "{\"event name\": \"" + name + "\", \"time\": " + std::to_string(time) +
+           ", \"general game updates\": {}, \"team a updates\": {}, \"team b updates\": {}, "
+           "\"description\": \"At " + std::to_string(time) + "\"}";
+}
+
+static void append(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::app);
+    out << text;
+}
+
+static void rewrite(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::trunc);
+    out << text;
+}
+
+// Events handed to the callback, in order
+struct Received {
+    std::mutex mtx;
+    std::vector<std::string> events;
+
+    Received() : mtx(), events() {}
+
+    void add(const std::string& team_a, const Event& event) {
+        std::lock_guard<std::mutex> lock(mtx);
+        events.push_back(team_a + "/" + event.get_name());
+    }
+
+    // Wait up to a second for count events
+    bool waitFor(size_t count) {
+        for (int i = 0; i < 100; i++) {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (events.size() >= count) {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    std::vector<std::string> snapshot() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return events;
+    }
+};
+
+void testPartialLines() {
+    std::cout << "\n=== Test: Partial Lines Held Back ===" << std::endl;
+
+    std::string path = "test_report_follower_a.jsonl";
+    rewrite(path, "{\"team a\": \"Germany\", \"team b\": \"Japan\"}\n" + eventLine("kickoff", 0) + "\n");
+
+    Received received;
+    ReportFollower follower([&received](const std::string& team_a, const std::string&, const Event& event) {
+        received.add(team_a, event);
+    });
+    std::string error;
+    check(follower.follow(path, error), "Follows an existing file");
+    check(received.waitFor(1), "Existing event read on follow");
+
+    std::string line = eventLine("goal", 10);
+    append(path, line.substr(0, 30));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    check(received.snapshot().size() == 1, "Line without its newline held back");
+
+    append(path, line.substr(30) + "\n");
+    check(received.waitFor(2) && received.snapshot()[1] == "Germany/goal", "Line handed over once completed");
+
+    append(path, "not json\n" + eventLine("halftime", 45) + "\n");
+    check(received.waitFor(3) && received.snapshot()[2] == "Germany/halftime", "Malformed line skipped");
+
+    std::remove(path.c_str());
+}
+
+void testTruncation() {
+    std::cout << "\n=== Test: Truncated File Read From the Start ===" << std::endl;
+
+    std::string path = "test_report_follower_b.jsonl";
+    rewrite(path, "{\"team a\": \"Germany\", \"team b\": \"Japan\"}\n" + eventLine("kickoff", 0) + "\n" +
+                  eventLine("goal", 10) + "\n");
+
+    Received received;
+    ReportFollower follower([&received](const std::string& team_a, const std::string&, const Event& event) {
+        received.add(team_a, event);
+    });
+    std::string error;
+    follower.follow(path, error);
+    check(received.waitFor(2), "Both events read");
+
+    // Shorter than what was read: the offset and header start over
+    rewrite(path, "{\"team a\": \"Spain\", \"team b\": \"Brazil\"}\n" + eventLine("kickoff", 0) + "\n");
+    check(received.waitFor(3) && received.snapshot()[2] == "Spain/kickoff", "New header and event read");
+
+    std::remove(path.c_str());
+}
+
+void testSameFileTwice() {
+    std::cout << "\n=== Test: One File Under Two Paths ===" << std::endl;
+
+    std::string path = "test_report_follower_c.jsonl";
+    rewrite(path, "{\"team a\": \"Germany\", \"team b\": \"Japan\"}\n");
+
+    ReportFollower follower([](const std::string&, const std::string&, const Event&) {});
+    std::string error;
+    check(follower.follow(path, error), "First path followed");
+    check(!follower.follow(path, error), "Same path rejected");
+    check(!follower.follow("./" + path, error) && error.find(path) != std::string::npos,
+          "Other path to the same file rejected");
+    check(follower.unfollow(path) && !follower.unfollow("./" + path), "Only the first path was followed");
+    check(follower.follow("./" + path, error), "Followable again once unfollowed");
+
+    std::remove(path.c_str());
+}
+
+void testBlockedCallback() {
+    std::cout << "\n=== Test: Blocked Callback Doesn't Hold the Lock ===" << std::endl;
+
+    std::string path = "test_report_follower_d.jsonl";
+    std::string other = "test_report_follower_e.jsonl";
+    rewrite(path, "{\"team a\": \"Germany\", \"team b\": \"Japan\"}\n" + eventLine("kickoff", 0) + "\n");
+    rewrite(other, "{\"team a\": \"Spain\", \"team b\": \"Brazil\"}\n");
+
+    // Stands in for a SEND stuck behind a stalled socket
+    std::atomic<bool> entered(false);
+    std::atomic<bool> release(false);
+    ReportFollower follower([&entered, &release](const std::string&, const std::string&, const Event&) {
+        entered = true;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    std::string error;
+    follower.follow(path, error);
+    for (int i = 0; i < 100 && !entered; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    check(entered, "Callback entered");
+
+    std::atomic<bool> done(false);
+    std::thread commands([&follower, &other, &path, &done]() {
+        std::string error;
+        follower.follow(other, error);
+        follower.unfollow(path);
+        done = true;
+    });
+    for (int i = 0; i < 100 && !done; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool finished = done;
+    release = true;
+    commands.join();
+    check(finished, "follow and unfollow return while the callback blocks");
+
+    std::remove(path.c_str());
+    std::remove(other.c_str());
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Report Follower Tests                               ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testPartialLines();
+    testTruncation();
+    testSameFileTwice();
+    testBlockedCallback();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL REPORT FOLLOWER TESTS PASSED!                ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include "../client/include/SendWindow.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+// The current window, from the "in flight N/W frames" stats line
+static size_t windowOf(SendWindow& window) {
+    std::ostringstream stats;
+    window.printStats(stats);
+    std::string text = stats.str();
+    size_t slash = text.find('/', text.find("in flight"));
+    return std::stoul(text.substr(slash + 1));
+}
+
+// Acquire n frames, tracking a receipt wherever one is asked for; returns the last id used
+static int send(SendWindow& window, int n, int& nextReceipt) {
+    int last = -1;
+    for (int i = 0; i < n; i++) {
+        bool wantReceipt = false;
+        window.acquire(wantReceipt);
+        if (wantReceipt) {
+            last = nextReceipt++;
+            window.track(last);
+        }
+    }
+    return last;
+}
+
+void testBlocksAtLimit() {
+    std::cout << "\n=== Test: Acquire Blocks at the Window Limit ===" << std::endl;
+
+    SendWindow window;
+    window.setWindow(4);
+    window.setReceiptEvery(2);
+
+    bool wantReceipt = false;
+    check(window.acquire(wantReceipt) && !wantReceipt, "First frame needs no receipt");
+    check(window.acquire(wantReceipt) && wantReceipt, "Every second frame asks for a receipt");
+    window.track(1);
+    window.acquire(wantReceipt);
+    check(window.acquire(wantReceipt) && wantReceipt, "The frame filling the window asks for a receipt");
+    window.track(2);
+
+    std::atomic<bool> sent(false);
+    std::thread sender([&]() {
+        bool want = false;
+        window.acquire(want);
+        sent = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    check(!sent, "Fifth frame waits while four are unacknowledged");
+
+    check(!window.onReceipt(99), "Unknown receipt ignored");
+    check(window.onReceipt(1), "Receipt of the window accepted");
+    sender.join();
+    check(sent, "Receipt releases the blocked sender");
+}
+
+void testAdapt() {
+    std::cout << "\n=== Test: Window Adapts to Round Trips ===" << std::endl;
+
+    SendWindow window;
+    window.setWindow(8);
+    window.setReceiptEvery(4);
+    int nextReceipt = 1;
+
+    // The first round trip is the best seen, so the window opens by one receipt's worth
+    int id = send(window, 4, nextReceipt);
+    window.onReceipt(id);
+    check(windowOf(window) == 12, "Quick receipt grows the window by receiptEvery");
+
+    // Round trips far above the best seen mean the broker is queueing
+    size_t before = windowOf(window);
+    for (int i = 0; i < 3; i++) {
+        id = send(window, 4, nextReceipt);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        window.onReceipt(id);
+    }
+    check(windowOf(window) < before, "Slow receipts shrink the window");
+}
+
+void testCloseWakesSender() {
+    std::cout << "\n=== Test: Close Wakes a Blocked Sender ===" << std::endl;
+
+    SendWindow window;
+    window.setWindow(1);
+    bool wantReceipt = false;
+    window.acquire(wantReceipt);
+    check(wantReceipt, "A window of one asks for a receipt on every frame");
+
+    std::atomic<int> result(-1);
+    std::thread sender([&]() {
+        bool want = false;
+        result = window.acquire(want) ? 1 : 0;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    check(result == -1, "Sender blocked on the full window");
+
+    window.close();
+    sender.join();
+    check(result == 0, "Close releases it with false");
+    check(!window.acquire(wantReceipt), "Closed window refuses more frames");
+
+    window.reset();
+    check(window.acquire(wantReceipt), "Reset window accepts frames again");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Send Window Tests                                   ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testBlocksAtLimit();
+    testAdapt();
+    testCloseWakesSender();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL SEND WINDOW TESTS PASSED!                    ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -0,0 +1,254 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include "../client/include/StompProtocol.h"
+#include "../client/include/SavedSubscriptions.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+// Read from the broker side of the connection until count frames have arrived, or
+// for at most a second
+static std::vector<std::string> readFrames(tcp::socket& socket, size_t count) {
+    std::vector<std::string> frames;
+    std::string pending;
+    char buffer[4096];
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (frames.size() < count && std::chrono::steady_clock::now() < deadline) {
+        boost::system::error_code error;
+        if (socket.available(error) == 0 && !error) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        size_t n = socket.read_some(boost::asio::buffer(buffer), error);
+        if (error) {
+            break;
+        }
+        pending.append(buffer, n);
+        size_t end;
+        while ((end = pending.find('\0')) != std::string::npos) {
+            frames.push_back(pending.substr(0, end));
+            pending.erase(0, end + 1);
+        }
+    }
+    return frames;
+}
+
+// A StompProtocol logged in over loopback, with the test playing the broker
+struct Session {
+    boost::asio::io_service io;
+    tcp::acceptor acceptor;
+    tcp::socket broker;
+    ConnectionHandler handler;
+    StompProtocol protocol;
+
+    // ConnectionHandler takes a short, so not an ephemeral port
+    explicit Session(short port) :
+        io(), acceptor(io, tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port)),
+        broker(io), handler("127.0.0.1", port), protocol() {
+        std::thread accepting([this]() { acceptor.accept(broker); });
+        handler.connect();
+        accepting.join();
+        protocol.setConnectionHandler(&handler);
+    }
+
+    ~Session() {
+        protocol.setConnectionHandler(nullptr);
+    }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    // The output of one command or server frame
+    std::string run(const std::string& line) {
+        std::ostringstream out;
+        std::streambuf* saved = std::cout.rdbuf(out.rdbuf());
+        protocol.executeUserCommand(line);
+        std::cout.rdbuf(saved);
+        return out.str();
+    }
+
+    std::string receive(const std::string& frame, bool& more) {
+        std::ostringstream out;
+        std::streambuf* saved = std::cout.rdbuf(out.rdbuf());
+        std::vector<std::string> frames(1, frame);
+        more = protocol.receiveFrames(frames, std::vector<std::chrono::system_clock::time_point>());
+        std::cout.rdbuf(saved);
+        return out.str();
+    }
+};
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path);
+    out << content;
+}
+
+void testSavedSubscriptions() {
+    std::cout << "\n=== Test: Saved Subscriptions ===" << std::endl;
+
+    std::string path = "test_stomp_protocol_saved.subs";
+    std::remove(path.c_str());
+    {
+        SavedSubscriptions saved;
+        saved.setPath(path);
+        check(saved.load("meni").empty(), "No file, no saved channels");
+        saved.save("meni", {"germany_japan", "spain_japan"});
+        saved.save("dana", {"usa_mexico"});
+    }
+
+    // A fresh instance reads back what the last one wrote, in join order
+    SavedSubscriptions reloaded;
+    reloaded.setPath(path);
+    std::vector<std::string> expected = {"germany_japan", "spain_japan"};
+    check(reloaded.load("meni") == expected, "Channels round-trip in join order");
+    check(reloaded.load("dana") == std::vector<std::string>(1, "usa_mexico"), "Users kept apart");
+
+    reloaded.save("meni", std::vector<std::string>());
+    SavedSubscriptions emptied;
+    emptied.setPath(path);
+    check(emptied.load("meni").empty(), "Empty list erases the user");
+    check(emptied.load("dana").size() == 1, "Other users untouched");
+
+    std::ifstream in(path);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    check(content == "dana usa_mexico\n", "Erased user leaves no lines behind");
+
+    std::remove(path.c_str());
+}
+
+void testRestoreRollback() {
+    std::cout << "\n=== Test: ERROR Rolls Back Pipelined Subscriptions ===" << std::endl;
+
+    std::string path = "test_stomp_protocol_rollback.subs";
+    writeFile(path, "meni germany_japan\nmeni spain_japan\n");
+
+    Session session(17782);
+    session.run("config subscription-file " + path);
+    session.run("login 127.0.0.1:17782 meni films --restore");
+    session.run("join --ack client-individual usa_mexico");
+    check(session.run("stats").find("Acks: 1 subscriptions acking") != std::string::npos,
+          "Pending subscription tracked for acks");
+
+    std::vector<std::string> frames = readFrames(session.broker, 4);
+    check(frames.size() == 4 && Frame::peekCommand(frames[0]) == "CONNECT", "CONNECT sent first");
+    check(frames.size() == 4 && Frame::peekHeader(frames[1], "destination") == "/germany_japan" &&
+          Frame::peekHeader(frames[2], "destination") == "/spain_japan" &&
+          Frame::peekHeader(frames[3], "destination") == "/usa_mexico",
+          "Saved and new subscriptions pipelined behind it");
+
+    bool more = true;
+    std::string out = session.receive("ERROR\nmessage:Wrong password\n\n", more);
+    check(!more, "ERROR ends the session");
+    check(out.find("Rolled back 3 subscriptions") != std::string::npos, "All pending subscriptions rolled back");
+    check(session.run("stats").find("Acks: auto") != std::string::npos, "Rolled back subscriptions no longer acked");
+
+    SavedSubscriptions saved;
+    saved.setPath(path);
+    std::vector<std::string> expected = {"germany_japan", "spain_japan"};
+    check(saved.load("meni") == expected, "Failed login leaves the saved list as it was");
+
+    std::remove(path.c_str());
+}
+
+void testRestoreCommit() {
+    std::cout << "\n=== Test: CONNECTED Commits Pipelined Subscriptions ===" << std::endl;
+
+    std::string path = "test_stomp_protocol_commit.subs";
+    writeFile(path, "meni germany_japan\n");
+
+    Session session(17783);
+    session.run("config subscription-file " + path);
+    session.run("login 127.0.0.1:17783 meni films --restore");
+    session.run("join spain_japan");
+    readFrames(session.broker, 3);
+
+    bool more = false;
+    session.receive("CONNECTED\nversion:1.2\n\n", more);
+    check(more && session.protocol.isClientConnected(), "CONNECTED logs in");
+
+    SavedSubscriptions saved;
+    saved.setPath(path);
+    std::vector<std::string> expected = {"germany_japan", "spain_japan"};
+    check(saved.load("meni") == expected, "Restored and pending subscriptions saved");
+
+    session.run("exit germany_japan");
+    saved.setPath(path);
+    check(saved.load("meni") == std::vector<std::string>(1, "spain_japan"), "Exit saved");
+
+    std::remove(path.c_str());
+}
+
+void testShedMessagesAcked() {
+    std::cout << "\n=== Test: Shed Messages Still Acknowledged ===" << std::endl;
+
+    std::string path = "test_stomp_protocol_acks.subs";
+    Session session(17784);
+    session.run("config subscription-file " + path);
+    // Handled inline, one frame a second per channel: all but the first are shed
+    session.run("config inbound-workers 0");
+    session.run("config inbound-rate 1");
+    session.run("config inbound-policy drop-newest");
+    session.run("config ack-batch 1");
+    session.run("login 127.0.0.1:17784 meni films");
+    readFrames(session.broker, 1);
+    bool more = false;
+    session.receive("CONNECTED\nversion:1.2\n\n", more);
+    session.run("join --ack client-individual germany_japan");
+    std::vector<std::string> subscribe = readFrames(session.broker, 1);
+    check(subscribe.size() == 1 && Frame::peekHeader(subscribe[0], "ack") == "client-individual",
+          "Subscribed with client-individual acks");
+    std::string subscription = Frame::peekHeader(subscribe[0], "id");
+
+    const int total = 10;
+    for (int i = 1; i <= total; i++) {
+        std::string frame = "MESSAGE\nsubscription:" + subscription + "\nmessage-id:" + std::to_string(i) +
+                            "\nack:" + std::to_string(i) + "\ndestination:/germany_japan\n\n"
+                            "user: dana\nteam a: Germany\nteam b: Japan\nevent name: pass\ntime: " +
+                            std::to_string(i) + "\ngeneral game updates:\nteam a updates:\nteam b updates:\n"
+                            "description:\nshort pass\n";
+        session.receive(frame, more);
+    }
+
+    std::vector<std::string> acks = readFrames(session.broker, total);
+    std::vector<std::string> ids;
+    for (const std::string& ack : acks) {
+        if (Frame::peekCommand(ack) == "ACK") {
+            ids.push_back(Frame::peekHeader(ack, "id"));
+        }
+    }
+    std::sort(ids.begin(), ids.end(), [](const std::string& a, const std::string& b) {
+        return std::stoi(a) < std::stoi(b);
+    });
+    std::vector<std::string> expected;
+    for (int i = 1; i <= total; i++) {
+        expected.push_back(std::to_string(i));
+    }
+    check(ids == expected, "Every message acked, the shed ones included");
+
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  STOMP Protocol Tests                                ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testSavedSubscriptions();
+    testRestoreRollback();
+    testRestoreCommit();
+    testShedMessagesAcked();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL STOMP PROTOCOL TESTS PASSED!                 ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
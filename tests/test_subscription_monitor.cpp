@@ -0,0 +1,147 @@
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include "../client/include/SubscriptionMonitor.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+static uint64_t nowUs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// A raw MESSAGE as framing delivers it; sentAt 0 leaves out send-ts
+static std::string messageFrame(int subscription, int messageId, int sequence, uint64_t sentAt = 0) {
+    std::string frame = "MESSAGE\nsubscription:" + std::to_string(subscription) +
+                        "\nmessage-id:" + std::to_string(messageId) +
+                        "\nchannel-seq:" + std::to_string(sequence) + "\ndestination:/Germany_Japan\n";
+    if (sentAt != 0) {
+        frame += "send-ts:" + std::to_string(sentAt) + "\n";
+    }
+    return frame + "\nuser: meni\n";
+}
+
+static std::string stats(const SubscriptionMonitor& monitor) {
+    std::ostringstream out;
+    monitor.printStats(out);
+    return out.str();
+}
+
+void testGapsAndReordering() {
+    std::cout << "\n=== Test: Gaps, Reordering And Duplicates ===" << std::endl;
+
+    SubscriptionMonitor monitor;
+    monitor.track(3, "/Germany_Japan");
+    // Joined mid-channel at sequence 40; 43 and 44 lost, 46 arrives after 47,
+    // message 107 delivered twice
+    monitor.onReceived(messageFrame(3, 100, 40));
+    monitor.onReceived(messageFrame(3, 102, 41));
+    monitor.onReceived(messageFrame(3, 107, 42));
+    monitor.onReceived(messageFrame(3, 107, 42));
+    monitor.onReceived(messageFrame(3, 120, 45));
+    monitor.onReceived(messageFrame(3, 131, 47));
+    monitor.onReceived(messageFrame(3, 125, 46));
+
+    std::string out = stats(monitor);
+    check(out.find("Subscription 3 (/Germany_Japan): 7 received, 2 missing, 1 reordered, 1 duplicates")
+              != std::string::npos,
+          "Lost sequences counted, a late one taken back off");
+    check(out.find("lag") == std::string::npos, "No lag without handled messages");
+}
+
+void testUntrackedAndRange() {
+    std::cout << "\n=== Test: Untracked Subscriptions ===" << std::endl;
+
+    SubscriptionMonitor monitor;
+    monitor.onReceived(messageFrame(0, 1, 1));
+    monitor.onReceived("MESSAGE\nsubscription:99999999999\n\n");
+    check(stats(monitor) == "No active subscriptions\n", "Messages for unknown subscriptions are ignored");
+
+    monitor.track(2000, "/a");
+    monitor.track(5, "/b");
+    monitor.track(6, "/c");
+    monitor.onReceived(messageFrame(2000, 1, 1));
+    monitor.untrack(5);
+    std::string out = stats(monitor);
+    check(out.find("Subscription 2000 (/a): 1 received") != std::string::npos &&
+          out.find("/b") == std::string::npos,
+          "Ids in later chunks are tracked, exited ones dropped from stats");
+    check(out.find("1 of 2 subscriptions received nothing yet") != std::string::npos,
+          "Subscriptions without traffic are only counted");
+}
+
+void testRouting() {
+    std::cout << "\n=== Test: Routing By Subscription Id ===" << std::endl;
+
+    SubscriptionMonitor monitor;
+    for (int id = 0; id < 50000; id++) {
+        monitor.track(id, "/game_" + std::to_string(id));
+    }
+    const std::string* destination = monitor.destination(49999);
+    check(destination != nullptr && *destination == "/game_49999" && monitor.destination(50000) == nullptr,
+          "50k subscriptions resolve by id");
+    monitor.untrack(49999);
+    check(monitor.destination(49999) == nullptr && *destination == "/game_49999",
+          "Exited subscriptions stop routing, earlier lookups stay valid");
+}
+
+void testLag() {
+    std::cout << "\n=== Test: Consumer Lag ===" << std::endl;
+
+    SubscriptionMonitor monitor;
+    monitor.track(0, "/Germany_Japan");
+    // A sender clock 5 s ahead: the offset cancels out against the fastest delivery
+    uint64_t offset = 5000000;
+    monitor.onHandled(messageFrame(0, 1, 1, nowUs() + offset));
+    monitor.onHandled(messageFrame(0, 2, 2, nowUs() + offset - 30000));   // handled 30 ms late
+    std::string out = stats(monitor);
+    size_t max = out.find("(max ");
+    double maxLag = max == std::string::npos ? 0 : std::atof(out.c_str() + max + 5);
+    check(maxLag >= 29.0 && maxLag < 40.0, "Lag measured above the fastest delivery despite clock offset");
+    monitor.onHandled(messageFrame(0, 3, 3, nowUs() + offset));
+    out = stats(monitor);
+    check(std::atof(out.c_str() + out.find(", lag ") + 6) < 5.0, "Lag drops back once caught up");
+}
+
+void testConcurrentReaders() {
+    std::cout << "\n=== Test: Stats While Messages Flow ===" << std::endl;
+
+    SubscriptionMonitor monitor;
+    monitor.track(1, "/a");
+    std::thread socket([&monitor]() {
+        for (int i = 1; i <= 100000; i++) {
+            monitor.onReceived(messageFrame(1, i, i));
+        }
+    });
+    for (int i = 0; i < 100; i++) {
+        stats(monitor);
+    }
+    socket.join();
+    check(stats(monitor).find("100000 received, 0 missing, 0 reordered, 0 duplicates") != std::string::npos,
+          "Every message counted while stats were read");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Subscription Monitor Tests                          ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testGapsAndReordering();
+    testUntrackedAndRange();
+    testRouting();
+    testLag();
+    testConcurrentReaders();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL SUBSCRIPTION MONITOR TESTS PASSED!           ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <sstream>
+#include "../client/include/TimerWheel.h"
+#include "../client/include/HeartBeat.h"
+#include "../client/include/Histogram.h"
+
+void check(bool condition, const std::string& testName) {
+    if (!condition) {
+        std::cerr << "❌ FAILED: " << testName << std::endl;
+        exit(1);
+    }
+    std::cout << "✅ PASSED: " << testName << std::endl;
+}
+
+void testTimersFireInOrder() {
+    std::cout << "\n=== Test: Timers Fire In Deadline Order ===" << std::endl;
+
+    TimerWheel wheel;
+    std::mutex orderMtx;
+    std::vector<int> order;
+    TimerWheel::Clock::time_point start = TimerWheel::Clock::now();
+
+    // Past one full wheel revolution (1024 ticks) to exercise the rounds check
+    int delaysMs[] = {30, 5, 1100, 15};
+    for (int delay : delaysMs) {
+        TimerWheel::Clock::time_point due = start + std::chrono::milliseconds(delay);
+        wheel.schedule(due, [delay, due, &order, &orderMtx]() {
+            std::lock_guard<std::mutex> lock(orderMtx);
+            if (TimerWheel::Clock::now() >= due) {
+                order.push_back(delay);
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1300));
+    std::lock_guard<std::mutex> lock(orderMtx);
+    check(order.size() == 4, "All timers fired, none early");
+    check(order[0] == 5 && order[1] == 15 && order[2] == 30 && order[3] == 1100, "Timers fired in deadline order");
+}
+
+void testCancel() {
+    std::cout << "\n=== Test: Cancel ===" << std::endl;
+
+    TimerWheel wheel;
+    std::atomic<int> fired(0);
+    TimerWheel::TimerId id = wheel.scheduleAfter(std::chrono::milliseconds(20), [&fired]() { fired++; });
+    wheel.scheduleAfter(std::chrono::milliseconds(20), [&fired]() { fired += 10; });
+
+    check(wheel.cancel(id), "Pending timer cancelled");
+    check(!wheel.cancel(id), "Second cancel reports nothing pending");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    check(fired == 10, "Only the uncancelled timer fired");
+    check(wheel.pending() == 0, "No timers left pending");
+}
+
+void testHeartBeatNegotiation() {
+    std::cout << "\n=== Test: Heart-Beat Negotiation ===" << std::endl;
+
+    uint64_t sendMs;
+    uint64_t expectMs;
+    HeartBeat::negotiate(10000, 10000, 1000, 0, sendMs, expectMs);
+    check(sendMs == 0 && expectMs == 10000, "Server not asking for beats: send none, expect at the slower rate");
+    HeartBeat::negotiate(500, 2000, 1000, 3000, sendMs, expectMs);
+    check(sendMs == 3000 && expectMs == 2000, "Each direction takes the larger of the two intervals");
+    HeartBeat::negotiate(0, 0, 1000, 1000, sendMs, expectMs);
+    check(sendMs == 0 && expectMs == 0, "0,0 turns heart-beating off");
+
+    uint64_t first;
+    uint64_t second;
+    check(HeartBeat::parse("1000,250", first, second) && first == 1000 && second == 250, "Header parsed");
+    check(!HeartBeat::parse("1000", first, second) && !HeartBeat::parse("a,b", first, second), "Malformed header rejected");
+}
+
+void testHeartBeatTimers() {
+    std::cout << "\n=== Test: Heart-Beat Send And Timeout ===" << std::endl;
+
+    TimerWheel wheel(std::chrono::microseconds(2000), 256);
+    typedef HeartBeat::Clock Clock;
+    std::atomic<int64_t> lastSent(Clock::now().time_since_epoch().count());
+    std::atomic<int64_t> lastReceived(Clock::now().time_since_epoch().count());
+    std::atomic<int> beats(0);
+    std::atomic<int> timeouts(0);
+
+    HeartBeat heartBeat(wheel);
+    heartBeat.start(20, 20,
+        [&lastSent]() { return Clock::time_point(Clock::duration(lastSent.load())); },
+        [&lastReceived]() { return Clock::time_point(Clock::duration(lastReceived.load())); },
+        [&beats, &lastSent]() { beats++; lastSent = Clock::now().time_since_epoch().count(); return true; },
+        [&timeouts]() { timeouts++; });
+
+    // Other writes and regular reads: no beat needed and the peer is alive
+    for (int i = 0; i < 10; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        lastSent = lastReceived = Clock::now().time_since_epoch().count();
+    }
+    check(beats == 0, "No beat while other writes keep the link busy");
+    check(timeouts == 0, "No timeout while the peer keeps sending");
+
+    // Idle in both directions
+    std::this_thread::sleep_for(std::chrono::milliseconds(110));
+    check(beats >= 3, "Beats sent while idle");
+    check(timeouts == 1, "Silent peer timed out once");
+
+    heartBeat.stop();
+    int beatsAtStop = beats;
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    check(beats == beatsAtStop && wheel.pending() == 0, "stop() cancels the timers");
+}
+
+void testHistogram() {
+    std::cout << "\n=== Test: Histogram Percentiles ===" << std::endl;
+
+    Histogram histogram;
+    for (uint64_t v = 1; v <= 10000; v++) {
+        histogram.record(v);
+    }
+
+    check(histogram.count() == 10000, "Count matches samples");
+    check(histogram.min() == 1 && histogram.max() == 10000, "Min and max are exact");
+
+    uint64_t p50 = histogram.percentile(50);
+    uint64_t p99 = histogram.percentile(99);
+    check(p50 >= 5000 && p50 <= 5000 * 1.04, "p50 within bucket precision");
+    check(p99 >= 9900 && p99 <= 9900 * 1.04, "p99 within bucket precision");
+
+    histogram.reset();
+    check(histogram.count() == 0 && histogram.percentile(99) == 0, "Reset clears samples");
+}
+
+void testHeartBeatStuckBeat() {
+    std::cout << "\n=== Test: Heart-Beat Holds No Lock While Beating ===" << std::endl;
+
+    TimerWheel wheel(std::chrono::microseconds(2000), 256);
+    typedef HeartBeat::Clock Clock;
+    Clock::time_point started = Clock::now();
+    std::atomic<bool> entered(false);
+    std::atomic<bool> release(false);
+    std::atomic<int> attempts(0);
+
+    HeartBeat heartBeat(wheel);
+    // The first beat hangs, as a write to a stalled peer would; later ones can't be written
+    heartBeat.start(20, 0,
+        [started]() { return started; },
+        [started]() { return started; },
+        [&entered, &release, &attempts]() {
+            if (attempts++ == 0) {
+                entered = true;
+                while (!release) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            return false;
+        },
+        []() {});
+    for (int i = 0; i < 100 && !entered; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    check(entered, "Beat attempted while idle");
+
+    std::atomic<bool> done(false);
+    std::string stats;
+    std::thread reader([&heartBeat, &done, &stats]() {
+        std::ostringstream out;
+        heartBeat.printStats(out);
+        stats = out.str();
+        done = true;
+    });
+    for (int i = 0; i < 100 && !done; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bool finished = done;
+    release = true;
+    reader.join();
+    check(finished, "Stats readable while a beat is stuck");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    heartBeat.stop();
+    check(attempts >= 2, "Beats still attempted after one couldn't be written");
+    check(stats.find(" 0 beats sent") != std::string::npos, "Unwritten beats not counted");
+}
+
+int main() {
+    std::cout << "╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  Timer Wheel & Histogram Tests                       ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+
+    testTimersFireInOrder();
+    testCancel();
+    testHeartBeatNegotiation();
+    testHeartBeatTimers();
+    testHeartBeatStuckBeat();
+    testHistogram();
+
+    std::cout << "\n╔═══════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║  ✅ ALL TIMER TESTS PASSED!                          ║" << std::endl;
+    std::cout << "╚═══════════════════════════════════════════════════════╝" << std::endl;
+    return 0;
+}